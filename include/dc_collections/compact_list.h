@@ -0,0 +1,96 @@
+#ifndef LIBDC_COLLECTIONS_COMPACT_LIST_H
+#define LIBDC_COLLECTIONS_COMPACT_LIST_H
+
+
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/comparator.h"
+#include "dc_collections/predicate.h"
+#include "dc_collections/visitor.h"
+#include <dc_env/env.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/**
+ * A doubly linked list whose nodes live in one growable array and link to each other with 32-bit indices.
+ * Each item costs 16 bytes and no per-node allocation, and freed slots are reused before the array grows.
+ * Every list owns its own array, so concat, splice and split_at copy the moved items into the other array
+ * rather than relinking them, except that moving a whole list into an empty one hands the array over.
+ *
+ * A snapshot is the list header plus a flat copy of the node array. It holds the item pointers, not the
+ * items they point to.
+ */
+struct dc_compact_list;
+
+
+struct dc_compact_list_item
+{
+    ssize_t index;
+    void *data;
+};
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+struct dc_compact_list *dc_compact_list_create(const struct dc_env *env, struct dc_error *err, dc_comparator comparator);
+void dc_compact_list_destroy(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list);
+bool dc_compact_list_reserve(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t capacity);
+bool dc_compact_list_is_empty(const struct dc_env *env, const struct dc_compact_list *list);
+size_t dc_compact_list_size(const struct dc_env *env, const struct dc_compact_list *list);
+void dc_compact_list_clear(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list);
+bool dc_compact_list_add_first(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item);
+ssize_t dc_compact_list_add_last(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item);
+bool dc_compact_list_add_at(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index, const void *item);
+void *dc_compact_list_set(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index, const void *item);
+struct dc_compact_list_item dc_compact_list_get_first(const struct dc_env *env, const struct dc_compact_list *list);
+struct dc_compact_list_item dc_compact_list_get_last(const struct dc_env *env, const struct dc_compact_list *list);
+struct dc_compact_list_item dc_compact_list_get_at(const struct dc_env *env, const struct dc_compact_list *list, size_t index);
+struct dc_compact_list_item dc_compact_list_get_first_occurrence(const struct dc_env *env, const struct dc_compact_list *list, const void *item);
+struct dc_compact_list_item dc_compact_list_get_last_occurrence(const struct dc_env *env, const struct dc_compact_list *list, const void *item);
+bool dc_compact_list_contains(const struct dc_env *env, const struct dc_compact_list *list, const void *item);
+struct dc_compact_list_item dc_compact_list_remove_first(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list);
+struct dc_compact_list_item dc_compact_list_remove_last(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list);
+struct dc_compact_list_item dc_compact_list_remove_at(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index);
+struct dc_compact_list_item dc_compact_list_remove_first_occurrence(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item);
+struct dc_compact_list_item dc_compact_list_remove_last_occurrence(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item);
+size_t dc_compact_list_remove_all_occurrences(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item);
+size_t dc_compact_list_remove_if(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state);
+size_t dc_compact_list_retain_if(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state);
+ssize_t dc_compact_list_index_of(const struct dc_env *env, const struct dc_compact_list *list, const void *item);
+ssize_t dc_compact_list_last_index_of(const struct dc_env *env, const struct dc_compact_list *list, const void *item);
+void dc_compact_list_to_array(const struct dc_env *env, const struct dc_compact_list *list, void *array, size_t count);
+void dc_compact_list_concat(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, struct dc_compact_list *other);
+void dc_compact_list_splice(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index, struct dc_compact_list *other, size_t from_index, size_t to_index);
+struct dc_compact_list *dc_compact_list_split_at(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index);
+void dc_compact_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_compact_list *list, dc_visitor visitor, void *state);
+size_t dc_compact_list_snapshot_size(const struct dc_env *env, const struct dc_compact_list *list);
+void dc_compact_list_snapshot(const struct dc_env *env, const struct dc_compact_list *list, void *buffer);
+struct dc_compact_list *dc_compact_list_restore(const struct dc_env *env, struct dc_error *err, dc_comparator comparator, const void *buffer, size_t size);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // LIBDC_COLLECTIONS_COMPACT_LIST_H
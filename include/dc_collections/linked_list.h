@@ -20,6 +20,7 @@
 
 
 #include "dc_collections/comparator.h"
+#include "dc_collections/predicate.h"
 #include "dc_collections/visitor.h"
 #include <dc_env/env.h>
 #include <stdbool.h>
@@ -63,9 +64,14 @@ struct dc_linked_list_item dc_linked_list_remove_at(const struct dc_env *env, st
 struct dc_linked_list_item dc_linked_list_remove_first_occurrence(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, const void *item);
 struct dc_linked_list_item dc_linked_list_remove_last_occurrence(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, const void *item);
 size_t dc_linked_list_remove_all_occurrences(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, const void *item);
+size_t dc_linked_list_remove_if(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state);
+size_t dc_linked_list_retain_if(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state);
 ssize_t dc_linked_list_index_of(const struct dc_env *env, const struct dc_linked_list *list, const void *item);
 ssize_t dc_linked_list_last_index_of(const struct dc_env *env, const struct dc_linked_list *list, const void *item);
 void dc_linked_list_to_array(const struct dc_env *env, const struct dc_linked_list *list, void *array, size_t count);
+void dc_linked_list_concat(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, struct dc_linked_list *other);
+void dc_linked_list_splice(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, size_t index, struct dc_linked_list *other, size_t from_index, size_t to_index);
+struct dc_linked_list *dc_linked_list_split_at(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, size_t index);
 void dc_linked_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_linked_list *list, dc_visitor visitor, void *state);
 
 
@@ -0,0 +1,77 @@
+#ifndef LIBDC_COLLECTIONS_LRU_CACHE_H
+#define LIBDC_COLLECTIONS_LRU_CACHE_H
+
+
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/comparator.h"
+#include "dc_collections/hasher.h"
+#include <dc_env/env.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/**
+ * A bounded key/value cache that evicts the least recently used entry, with O(1) get, put and remove.
+ *
+ * Entries sit on a doubly linked recency list and in a hash index built from the hasher and comparator.
+ * When number_of_shards is 0 the cache is a single unsynchronised shard. Otherwise the keys are spread
+ * over that many shards, each with its own lock and an equal share of the capacity, and any number of
+ * threads can use the cache. The evictor is called outside the shard lock, once for each entry pushed
+ * out by a put. It is not called for remove or clear. The cache stores the key and value pointers
+ * without copying them. A put on a key that is already cached keeps the stored key, replaces the value
+ * and returns the old value.
+ */
+struct dc_lru_cache;
+
+
+typedef void (*dc_lru_cache_evictor)(const struct dc_env *env, struct dc_error *err, const void *key, void *value, void *state);
+
+
+struct dc_lru_cache_stats
+{
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+};
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+struct dc_lru_cache *dc_lru_cache_create(const struct dc_env *env, struct dc_error *err, size_t capacity, size_t number_of_shards, dc_hasher hasher, dc_comparator comparator, dc_lru_cache_evictor evictor, void *evictor_state);
+void dc_lru_cache_destroy(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache);
+size_t dc_lru_cache_size(const struct dc_env *env, struct dc_lru_cache *cache);
+size_t dc_lru_cache_capacity(const struct dc_env *env, const struct dc_lru_cache *cache);
+void dc_lru_cache_clear(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache);
+void *dc_lru_cache_get(const struct dc_env *env, struct dc_lru_cache *cache, const void *key);
+void *dc_lru_cache_peek(const struct dc_env *env, struct dc_lru_cache *cache, const void *key);
+bool dc_lru_cache_move_to_front(const struct dc_env *env, struct dc_lru_cache *cache, const void *key);
+void *dc_lru_cache_put(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache, const void *key, const void *value);
+void *dc_lru_cache_remove(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache, const void *key);
+struct dc_lru_cache_stats dc_lru_cache_get_stats(const struct dc_env *env, struct dc_lru_cache *cache);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // LIBDC_COLLECTIONS_LRU_CACHE_H
@@ -0,0 +1,61 @@
+#ifndef LIBDC_COLLECTIONS_RADIX_TREE_H
+#define LIBDC_COLLECTIONS_RADIX_TREE_H
+
+
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/visitor.h"
+#include <dc_env/env.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/**
+ * A set of NUL-terminated strings stored in an adaptive radix tree with path compression.
+ * Lookups cost O(key length) no matter how many strings are stored.
+ *
+ * The tree keeps the caller's string pointers, it does not copy them, so a string has to outlive its
+ * membership. Visits hand back those pointers in dc_string_comparator (byte) order.
+ */
+struct dc_radix_tree;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+struct dc_radix_tree *dc_radix_tree_create(const struct dc_env *env, struct dc_error *err);
+void dc_radix_tree_destroy(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree);
+bool dc_radix_tree_is_empty(const struct dc_env *env, const struct dc_radix_tree *tree);
+size_t dc_radix_tree_size(const struct dc_env *env, const struct dc_radix_tree *tree);
+void dc_radix_tree_clear(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree);
+bool dc_radix_tree_insert(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree, const char *key);
+bool dc_radix_tree_contains(const struct dc_env *env, const struct dc_radix_tree *tree, const char *key);
+const char *dc_radix_tree_get(const struct dc_env *env, const struct dc_radix_tree *tree, const char *key);
+const char *dc_radix_tree_remove(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree, const char *key);
+void dc_radix_tree_visit(const struct dc_env *env, struct dc_error *err, const struct dc_radix_tree *tree, dc_visitor visitor, void *state);
+void dc_radix_tree_visit_prefix(const struct dc_env *env, struct dc_error *err, const struct dc_radix_tree *tree, const char *prefix, dc_visitor visitor, void *state);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // LIBDC_COLLECTIONS_RADIX_TREE_H
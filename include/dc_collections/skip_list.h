@@ -0,0 +1,79 @@
+#ifndef LIBDC_COLLECTIONS_SKIP_LIST_H
+#define LIBDC_COLLECTIONS_SKIP_LIST_H
+
+
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/comparator.h"
+#include "dc_collections/visitor.h"
+#include <dc_env/env.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/**
+ * An ordered set kept in a skip list, giving O(log n) expected add, get and remove.
+ * dc_skip_list_visit_range visits the items from <= item < to, and a NULL bound leaves that end open.
+ *
+ * A list created with concurrent set to false is for one thread at a time. It keeps span counts,
+ * so get_at and index_of are O(log n) as well.
+ *
+ * A list created with concurrent set to true lets any number of threads call add, remove, contains,
+ * get and the visit functions at once. Readers never lock, and writers use compare-and-swap. Spans
+ * cannot be kept consistent without locking, so get_at and index_of walk the bottom level instead.
+ * Removed nodes are not freed until dc_skip_list_reclaim, dc_skip_list_clear or
+ * dc_skip_list_destroy runs. Those three must only be called while no other thread uses the list.
+ */
+struct dc_skip_list;
+
+
+struct dc_skip_list_item
+{
+    ssize_t index;
+    void *data;
+};
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+struct dc_skip_list *dc_skip_list_create(const struct dc_env *env, struct dc_error *err, dc_comparator comparator, bool concurrent);
+void dc_skip_list_destroy(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list);
+bool dc_skip_list_is_empty(const struct dc_env *env, const struct dc_skip_list *list);
+size_t dc_skip_list_size(const struct dc_env *env, const struct dc_skip_list *list);
+void dc_skip_list_clear(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list);
+bool dc_skip_list_add(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item);
+bool dc_skip_list_contains(const struct dc_env *env, const struct dc_skip_list *list, const void *item);
+void *dc_skip_list_get(const struct dc_env *env, const struct dc_skip_list *list, const void *item);
+void *dc_skip_list_remove(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item);
+struct dc_skip_list_item dc_skip_list_get_at(const struct dc_env *env, const struct dc_skip_list *list, size_t index);
+ssize_t dc_skip_list_index_of(const struct dc_env *env, const struct dc_skip_list *list, const void *item);
+void dc_skip_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_skip_list *list, dc_visitor visitor, void *state);
+void dc_skip_list_visit_range(const struct dc_env *env, struct dc_error *err, const struct dc_skip_list *list, const void *from, const void *to, dc_visitor visitor, void *state);
+void dc_skip_list_reclaim(const struct dc_env *env, struct dc_skip_list *list);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // LIBDC_COLLECTIONS_SKIP_LIST_H
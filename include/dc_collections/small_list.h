@@ -0,0 +1,93 @@
+#ifndef LIBDC_COLLECTIONS_SMALL_LIST_H
+#define LIBDC_COLLECTIONS_SMALL_LIST_H
+
+
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/comparator.h"
+#include "dc_collections/visitor.h"
+#include <dc_env/env.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+
+// part of the struct layout the library is built with, so it is fixed
+#define DC_SMALL_LIST_INLINE_CAPACITY 4
+
+
+struct dc_small_list_node;
+
+
+/**
+ * A list that keeps its first DC_SMALL_LIST_INLINE_CAPACITY items inside the header and only allocates
+ * nodes for the items after that.
+ *
+ * The layout is public so the header can be embedded in another struct or placed on the stack and set up
+ * with dc_small_list_init. An embedded list must be emptied with dc_small_list_clear before it goes away.
+ * The header never points into itself, so it can be moved with a plain memory copy.
+ */
+struct dc_small_list
+{
+    size_t number_of_elements;
+    dc_comparator comparator;
+    const void *inline_data[DC_SMALL_LIST_INLINE_CAPACITY];
+    struct dc_small_list_node *overflow_head;
+    struct dc_small_list_node *overflow_tail;
+};
+
+
+struct dc_small_list_item
+{
+    ssize_t index;
+    void *data;
+};
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+void dc_small_list_init(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, dc_comparator comparator);
+struct dc_small_list *dc_small_list_create(const struct dc_env *env, struct dc_error *err, dc_comparator comparator);
+void dc_small_list_destroy(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list);
+bool dc_small_list_is_empty(const struct dc_env *env, const struct dc_small_list *list);
+size_t dc_small_list_size(const struct dc_env *env, const struct dc_small_list *list);
+void dc_small_list_clear(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list);
+bool dc_small_list_add_first(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, const void *item);
+ssize_t dc_small_list_add_last(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, const void *item);
+bool dc_small_list_add_at(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, size_t index, const void *item);
+void *dc_small_list_set(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, size_t index, const void *item);
+struct dc_small_list_item dc_small_list_get_first(const struct dc_env *env, const struct dc_small_list *list);
+struct dc_small_list_item dc_small_list_get_last(const struct dc_env *env, const struct dc_small_list *list);
+struct dc_small_list_item dc_small_list_get_at(const struct dc_env *env, const struct dc_small_list *list, size_t index);
+bool dc_small_list_contains(const struct dc_env *env, const struct dc_small_list *list, const void *item);
+ssize_t dc_small_list_index_of(const struct dc_env *env, const struct dc_small_list *list, const void *item);
+struct dc_small_list_item dc_small_list_remove_first(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list);
+struct dc_small_list_item dc_small_list_remove_last(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list);
+struct dc_small_list_item dc_small_list_remove_at(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, size_t index);
+void dc_small_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_small_list *list, dc_visitor visitor, void *state);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif // LIBDC_COLLECTIONS_SMALL_LIST_H
@@ -0,0 +1,1262 @@
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/compact_list.h"
+#include <dc_c/dc_stdlib.h>
+#include <dc_c/dc_string.h>
+#include <stdint.h>
+
+
+#define NIL UINT32_MAX
+#define MIN_CAPACITY 16
+
+
+struct node
+{
+    const void *data;
+    uint32_t next;
+    uint32_t prev;
+};
+
+struct dc_compact_list
+{
+    size_t number_of_elements;
+    dc_comparator comparator;
+    struct node *nodes;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t free_head;
+};
+
+struct occurrence
+{
+    dc_comparator comparator;
+    const void *item;
+};
+
+struct snapshot_header
+{
+    uint64_t number_of_elements;
+    uint32_t used;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t free_head;
+};
+
+static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_compact_list *list, size_t number_of_elements);
+static bool grow(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t min_capacity);
+static uint32_t allocate_slot(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list);
+static void unlink_slot(const struct dc_env *env, struct dc_compact_list *list, uint32_t slot);
+static void release_slot(const struct dc_env *env, struct dc_compact_list *list, uint32_t slot);
+static void *remove_slot(const struct dc_env *env, struct dc_compact_list *list, uint32_t slot);
+static void remove_slots(const struct dc_env *env, struct dc_compact_list *list, uint32_t first, size_t count);
+static size_t remove_matching(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, dc_predicate predicate, void *predicate_state, bool remove_when, dc_visitor removed, void *removed_state);
+static bool is_occurrence(const struct dc_env *env, const void *item, void *state);
+static bool copy_slots(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, uint32_t prev, const struct dc_compact_list *other, uint32_t first, size_t count);
+static void swap_nodes(const struct dc_env *env, struct dc_compact_list *list, struct dc_compact_list *other);
+static uint32_t get_slot_at(const struct dc_env *env, const struct dc_compact_list *list, size_t index);
+static uint32_t get_first_slot_with(const struct dc_env *env, const struct dc_compact_list *list, const void *item, size_t *index);
+static uint32_t get_last_slot_with(const struct dc_env *env, const struct dc_compact_list *list, const void *item, size_t *index);
+static bool is_valid_slot(const struct dc_env *env, uint32_t slot, uint32_t used);
+static bool is_valid_chain(const struct dc_env *env, const struct node *nodes, const struct snapshot_header *header);
+
+static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_compact_list *list, size_t number_of_elements)
+{
+    DC_TRACE(env);
+
+    if(list->comparator == NULL)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    if(list->number_of_elements != number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 2);
+        return;
+    }
+
+    if(list->number_of_elements > list->used || list->used > list->capacity)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 3);
+        return;
+    }
+
+    if(list->number_of_elements == 0)
+    {
+        if(list->head != NIL || list->tail != NIL)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", 4);
+            return;
+        }
+    }
+    else
+    {
+        if(list->head == NIL || list->nodes[list->head].prev != NIL)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", 5);
+            return;
+        }
+
+        if(list->tail == NIL || list->nodes[list->tail].next != NIL)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", 6);
+            return;
+        }
+    }
+}
+
+static bool grow(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t min_capacity)
+{
+    size_t new_capacity;
+    struct node *nodes;
+
+    DC_TRACE(env);
+
+    // NIL is never a valid slot, so UINT32_MAX slots is the most the indices can address
+    if(min_capacity > NIL)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+
+        return false;
+    }
+
+    new_capacity = (size_t)list->capacity + (list->capacity / 2);
+
+    if(new_capacity < MIN_CAPACITY)
+    {
+        new_capacity = MIN_CAPACITY;
+    }
+
+    if(new_capacity < min_capacity)
+    {
+        new_capacity = min_capacity;
+    }
+
+    if(new_capacity > NIL)
+    {
+        new_capacity = NIL;
+    }
+
+    nodes = dc_realloc(env, err, list->nodes, new_capacity * sizeof(struct node));
+
+    if(dc_error_has_error(err))
+    {
+        return false;
+    }
+
+    list->nodes = nodes;
+    list->capacity = (uint32_t)new_capacity;
+
+    return true;
+}
+
+static uint32_t allocate_slot(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list)
+{
+    uint32_t slot;
+
+    DC_TRACE(env);
+
+    if(list->free_head != NIL)
+    {
+        slot = list->free_head;
+        list->free_head = list->nodes[slot].next;
+    }
+    else
+    {
+        if(list->used == list->capacity && !grow(env, err, list, (size_t)list->used + 1))
+        {
+            return NIL;
+        }
+
+        slot = list->used;
+        list->used++;
+    }
+
+    return slot;
+}
+
+static void unlink_slot(const struct dc_env *env, struct dc_compact_list *list, uint32_t slot)
+{
+    const struct node *node;
+
+    DC_TRACE(env);
+    node = &list->nodes[slot];
+
+    if(node->prev != NIL)
+    {
+        list->nodes[node->prev].next = node->next;
+    }
+    else
+    {
+        list->head = node->next;
+    }
+
+    if(node->next != NIL)
+    {
+        list->nodes[node->next].prev = node->prev;
+    }
+    else
+    {
+        list->tail = node->prev;
+    }
+
+    list->number_of_elements--;
+}
+
+static void release_slot(const struct dc_env *env, struct dc_compact_list *list, uint32_t slot)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    node = &list->nodes[slot];
+    node->data = NULL;
+    node->prev = NIL;
+    node->next = list->free_head;
+    list->free_head = slot;
+}
+
+static void *remove_slot(const struct dc_env *env, struct dc_compact_list *list, uint32_t slot)
+{
+    void *data;
+
+    DC_TRACE(env);
+    data = (void *)(uintptr_t)list->nodes[slot].data;
+    unlink_slot(env, list, slot);
+    release_slot(env, list, slot);
+
+    return data;
+}
+
+static void remove_slots(const struct dc_env *env, struct dc_compact_list *list, uint32_t first, size_t count)
+{
+    uint32_t slot;
+
+    DC_TRACE(env);
+    slot = first;
+
+    for(size_t removed = 0; removed < count; removed++)
+    {
+        uint32_t next;
+
+        next = list->nodes[slot].next;
+        remove_slot(env, list, slot);
+        slot = next;
+    }
+}
+
+static size_t remove_matching(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, dc_predicate predicate, void *predicate_state, bool remove_when, dc_visitor removed, void *removed_state)
+{
+    size_t number_of_elements;
+    size_t count;
+    uint32_t removed_head;
+    uint32_t removed_tail;
+    uint32_t slot;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    count = 0;
+    removed_head = NIL;
+    removed_tail = NIL;
+    slot = list->head;
+
+    // unlink the matches onto a detached chain so the list is only walked once
+    while(slot != NIL)
+    {
+        uint32_t next;
+
+        next = list->nodes[slot].next;
+
+        if(predicate(env, list->nodes[slot].data, predicate_state) == remove_when)
+        {
+            unlink_slot(env, list, slot);
+            list->nodes[slot].next = NIL;
+
+            if(removed_tail != NIL)
+            {
+                list->nodes[removed_tail].next = slot;
+            }
+            else
+            {
+                removed_head = slot;
+            }
+
+            removed_tail = slot;
+            count++;
+        }
+
+        slot = next;
+    }
+
+    check_list(env, err, list, number_of_elements - count);
+
+    // hand the items back and free the slots once the list is consistent again
+    for(slot = removed_head; slot != NIL;)
+    {
+        uint32_t next;
+
+        next = list->nodes[slot].next;
+
+        if(removed)
+        {
+            removed(env, err, list->nodes[slot].data, removed_state);
+        }
+
+        release_slot(env, list, slot);
+        slot = next;
+    }
+
+    return count;
+}
+
+static bool is_occurrence(const struct dc_env *env, const void *item, void *state)
+{
+    const struct occurrence *occurrence;
+
+    DC_TRACE(env);
+    occurrence = state;
+
+    return occurrence->comparator(env, occurrence->item, item) == 0;
+}
+
+static bool copy_slots(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, uint32_t prev, const struct dc_compact_list *other, uint32_t first, size_t count)
+{
+    size_t free_slots;
+    uint32_t next;
+    uint32_t source;
+
+    DC_TRACE(env);
+    free_slots = (size_t)list->used - list->number_of_elements;
+
+    // grow once up front so allocate_slot can not fail part way through the copy
+    if(count > free_slots && !dc_compact_list_reserve(env, err, list, (size_t)list->used + (count - free_slots)))
+    {
+        return false;
+    }
+
+    next = (prev == NIL) ? list->head : list->nodes[prev].next;
+    source = first;
+
+    for(size_t copied = 0; copied < count; copied++)
+    {
+        uint32_t slot;
+
+        slot = allocate_slot(env, err, list);
+        list->nodes[slot].data = other->nodes[source].data;
+        list->nodes[slot].prev = prev;
+
+        if(prev != NIL)
+        {
+            list->nodes[prev].next = slot;
+        }
+        else
+        {
+            list->head = slot;
+        }
+
+        prev = slot;
+        source = other->nodes[source].next;
+    }
+
+    if(prev != NIL)
+    {
+        list->nodes[prev].next = next;
+    }
+
+    if(next != NIL)
+    {
+        list->nodes[next].prev = prev;
+    }
+    else
+    {
+        list->tail = prev;
+    }
+
+    list->number_of_elements += count;
+
+    return true;
+}
+
+static void swap_nodes(const struct dc_env *env, struct dc_compact_list *list, struct dc_compact_list *other)
+{
+    struct dc_compact_list tmp;
+
+    DC_TRACE(env);
+    tmp = *list;
+    list->number_of_elements = other->number_of_elements;
+    list->nodes = other->nodes;
+    list->capacity = other->capacity;
+    list->used = other->used;
+    list->head = other->head;
+    list->tail = other->tail;
+    list->free_head = other->free_head;
+    other->number_of_elements = tmp.number_of_elements;
+    other->nodes = tmp.nodes;
+    other->capacity = tmp.capacity;
+    other->used = tmp.used;
+    other->head = tmp.head;
+    other->tail = tmp.tail;
+    other->free_head = tmp.free_head;
+}
+
+static uint32_t get_slot_at(const struct dc_env *env, const struct dc_compact_list *list, size_t index)
+{
+    uint32_t slot;
+
+    DC_TRACE(env);
+
+    if(index < list->number_of_elements / 2)
+    {
+        slot = list->head;
+
+        for(size_t current_index = 0; current_index < index; current_index++)
+        {
+            slot = list->nodes[slot].next;
+        }
+    }
+    else
+    {
+        slot = list->tail;
+
+        for(size_t current_index = list->number_of_elements - 1; current_index > index; current_index--)
+        {
+            slot = list->nodes[slot].prev;
+        }
+    }
+
+    return slot;
+}
+
+static uint32_t get_first_slot_with(const struct dc_env *env, const struct dc_compact_list *list, const void *item, size_t *index)
+{
+    uint32_t slot;
+
+    DC_TRACE(env);
+    *index = 0;
+
+    for(slot = list->head; slot != NIL; slot = list->nodes[slot].next)
+    {
+        if(list->comparator(env, item, list->nodes[slot].data) == 0)
+        {
+            break;
+        }
+
+        (*index)++;
+    }
+
+    return slot;
+}
+
+static uint32_t get_last_slot_with(const struct dc_env *env, const struct dc_compact_list *list, const void *item, size_t *index)
+{
+    uint32_t slot;
+
+    DC_TRACE(env);
+    *index = list->number_of_elements;
+
+    for(slot = list->tail; slot != NIL; slot = list->nodes[slot].prev)
+    {
+        (*index)--;
+
+        if(list->comparator(env, item, list->nodes[slot].data) == 0)
+        {
+            break;
+        }
+    }
+
+    return slot;
+}
+
+static bool is_valid_slot(const struct dc_env *env, uint32_t slot, uint32_t used)
+{
+    DC_TRACE(env);
+
+    return slot == NIL || slot < used;
+}
+
+static bool is_valid_chain(const struct dc_env *env, const struct node *nodes, const struct snapshot_header *header)
+{
+    uint32_t prev;
+    uint32_t slot;
+
+    DC_TRACE(env);
+    prev = NIL;
+    slot = header->head;
+
+    // the live chain has to reach the tail in exactly number_of_elements steps with every back link agreeing
+    for(uint64_t count = 0; count < header->number_of_elements; count++)
+    {
+        if(slot == NIL || nodes[slot].prev != prev)
+        {
+            return false;
+        }
+
+        prev = slot;
+        slot = nodes[slot].next;
+
+        if(!is_valid_slot(env, slot, header->used))
+        {
+            return false;
+        }
+    }
+
+    if(slot != NIL || prev != header->tail)
+    {
+        return false;
+    }
+
+    // a free slot always has a NIL back link, which no live slot other than the head has
+    slot = header->free_head;
+
+    for(uint64_t count = 0; count < header->used - header->number_of_elements; count++)
+    {
+        if(slot == NIL || slot == header->head || nodes[slot].prev != NIL)
+        {
+            return false;
+        }
+
+        slot = nodes[slot].next;
+
+        if(!is_valid_slot(env, slot, header->used))
+        {
+            return false;
+        }
+    }
+
+    return slot == NIL;
+}
+
+struct dc_compact_list *dc_compact_list_create(const struct dc_env *env, struct dc_error *err, dc_comparator comparator)
+{
+    struct dc_compact_list *list;
+
+    DC_TRACE(env);
+    list = dc_calloc(env, err, 1, sizeof(struct dc_compact_list));
+
+    if(dc_error_has_no_error(err))
+    {
+        list->comparator = comparator;
+        list->head = NIL;
+        list->tail = NIL;
+        list->free_head = NIL;
+        check_list(env, err, list, 0);
+    }
+
+    return list;
+}
+
+void dc_compact_list_destroy(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list)
+{
+    DC_TRACE(env);
+    dc_compact_list_clear(env, err, list);
+
+    if(list->nodes)
+    {
+        dc_free(env, list->nodes);
+    }
+
+    dc_free(env, list);
+}
+
+bool dc_compact_list_reserve(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t capacity)
+{
+    bool ret_val;
+
+    DC_TRACE(env);
+
+    if(capacity <= list->capacity)
+    {
+        ret_val = true;
+    }
+    else
+    {
+        ret_val = grow(env, err, list, capacity);
+    }
+
+    return ret_val;
+}
+
+bool dc_compact_list_is_empty(const struct dc_env *env, const struct dc_compact_list *list)
+{
+    DC_TRACE(env);
+
+    return list->number_of_elements == 0;
+}
+
+size_t dc_compact_list_size(const struct dc_env *env, const struct dc_compact_list *list)
+{
+    DC_TRACE(env);
+
+    return list->number_of_elements;
+}
+
+void dc_compact_list_clear(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list)
+{
+    DC_TRACE(env);
+
+    // the node array is kept so the list can be refilled without growing again
+    list->number_of_elements = 0;
+    list->used = 0;
+    list->head = NIL;
+    list->tail = NIL;
+    list->free_head = NIL;
+    check_list(env, err, list, 0);
+}
+
+bool dc_compact_list_add_first(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item)
+{
+    bool ret_val;
+
+    DC_TRACE(env);
+    ret_val = dc_compact_list_add_at(env, err, list, 0, item);
+
+    return ret_val;
+}
+
+ssize_t dc_compact_list_add_last(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item)
+{
+    ssize_t ret_val;
+
+    DC_TRACE(env);
+    dc_compact_list_add_at(env, err, list, list->number_of_elements, item);
+
+    if(dc_error_has_error(err))
+    {
+        ret_val = -1;
+    }
+    else
+    {
+        ret_val = (ssize_t)list->number_of_elements;
+    }
+
+    return ret_val;
+}
+
+bool dc_compact_list_add_at(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index, const void *item)
+{
+    size_t number_of_elements;
+    uint32_t slot;
+    uint32_t prev;
+    uint32_t next;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+
+    if(index > number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+
+        return false;
+    }
+
+    // allocate first, growing the array moves the nodes
+    slot = allocate_slot(env, err, list);
+
+    if(slot == NIL)
+    {
+        return false;
+    }
+
+    if(index == number_of_elements)
+    {
+        prev = list->tail;
+        next = NIL;
+    }
+    else
+    {
+        next = get_slot_at(env, list, index);
+        prev = list->nodes[next].prev;
+    }
+
+    list->nodes[slot].data = item;
+    list->nodes[slot].prev = prev;
+    list->nodes[slot].next = next;
+
+    if(prev != NIL)
+    {
+        list->nodes[prev].next = slot;
+    }
+    else
+    {
+        list->head = slot;
+    }
+
+    if(next != NIL)
+    {
+        list->nodes[next].prev = slot;
+    }
+    else
+    {
+        list->tail = slot;
+    }
+
+    list->number_of_elements++;
+    check_list(env, err, list, number_of_elements + 1);
+
+    return dc_error_has_no_error(err);
+}
+
+void *dc_compact_list_set(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index, const void *item)
+{
+    void *old_data;
+
+    DC_TRACE(env);
+    old_data = NULL;
+
+    if(index >= list->number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+    }
+    else
+    {
+        struct node *node;
+
+        node = &list->nodes[get_slot_at(env, list, index)];
+        old_data = (void *)(uintptr_t)node->data;
+        node->data = item;
+    }
+
+    return old_data;
+}
+
+struct dc_compact_list_item dc_compact_list_get_first(const struct dc_env *env, const struct dc_compact_list *list)
+{
+    struct dc_compact_list_item item;
+
+    DC_TRACE(env);
+
+    if(list->head == NIL)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item.index = 0;
+        item.data = (void *)(uintptr_t)list->nodes[list->head].data;
+    }
+
+    return item;
+}
+
+struct dc_compact_list_item dc_compact_list_get_last(const struct dc_env *env, const struct dc_compact_list *list)
+{
+    struct dc_compact_list_item item;
+
+    DC_TRACE(env);
+
+    if(list->tail == NIL)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item.index = ((ssize_t)list->number_of_elements) - 1;
+        item.data = (void *)(uintptr_t)list->nodes[list->tail].data;
+    }
+
+    return item;
+}
+
+struct dc_compact_list_item dc_compact_list_get_at(const struct dc_env *env, const struct dc_compact_list *list, size_t index)
+{
+    struct dc_compact_list_item item;
+
+    DC_TRACE(env);
+
+    if(index >= list->number_of_elements)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item.index = (ssize_t)index;
+        item.data = (void *)(uintptr_t)list->nodes[get_slot_at(env, list, index)].data;
+    }
+
+    return item;
+}
+
+struct dc_compact_list_item dc_compact_list_get_first_occurrence(const struct dc_env *env, const struct dc_compact_list *list, const void *item)
+{
+    struct dc_compact_list_item found;
+    uint32_t slot;
+    size_t index;
+
+    DC_TRACE(env);
+    slot = get_first_slot_with(env, list, item, &index);
+
+    if(slot == NIL)
+    {
+        found.index = -1;
+        found.data = NULL;
+    }
+    else
+    {
+        found.index = (ssize_t)index;
+        found.data = (void *)(uintptr_t)list->nodes[slot].data;
+    }
+
+    return found;
+}
+
+struct dc_compact_list_item dc_compact_list_get_last_occurrence(const struct dc_env *env, const struct dc_compact_list *list, const void *item)
+{
+    struct dc_compact_list_item found;
+    uint32_t slot;
+    size_t index;
+
+    DC_TRACE(env);
+    slot = get_last_slot_with(env, list, item, &index);
+
+    if(slot == NIL)
+    {
+        found.index = -1;
+        found.data = NULL;
+    }
+    else
+    {
+        found.index = (ssize_t)index;
+        found.data = (void *)(uintptr_t)list->nodes[slot].data;
+    }
+
+    return found;
+}
+
+bool dc_compact_list_contains(const struct dc_env *env, const struct dc_compact_list *list, const void *item)
+{
+    size_t index;
+
+    DC_TRACE(env);
+
+    return get_first_slot_with(env, list, item, &index) != NIL;
+}
+
+struct dc_compact_list_item dc_compact_list_remove_first(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list)
+{
+    struct dc_compact_list_item item;
+
+    DC_TRACE(env);
+
+    if(list->head == NIL)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item = dc_compact_list_remove_at(env, err, list, 0);
+    }
+
+    return item;
+}
+
+struct dc_compact_list_item dc_compact_list_remove_last(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list)
+{
+    struct dc_compact_list_item item;
+
+    DC_TRACE(env);
+
+    if(list->tail == NIL)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item = dc_compact_list_remove_at(env, err, list, list->number_of_elements - 1);
+    }
+
+    return item;
+}
+
+struct dc_compact_list_item dc_compact_list_remove_at(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index)
+{
+    size_t number_of_elements;
+    struct dc_compact_list_item item;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+
+    if(index >= number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item.index = (ssize_t)index;
+        item.data = remove_slot(env, list, get_slot_at(env, list, index));
+        check_list(env, err, list, number_of_elements - 1);
+    }
+
+    return item;
+}
+
+struct dc_compact_list_item dc_compact_list_remove_first_occurrence(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item)
+{
+    struct dc_compact_list_item found;
+    size_t number_of_elements;
+    uint32_t slot;
+    size_t index;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    slot = get_first_slot_with(env, list, item, &index);
+
+    if(slot == NIL)
+    {
+        found.index = -1;
+        found.data = NULL;
+    }
+    else
+    {
+        found.index = (ssize_t)index;
+        found.data = remove_slot(env, list, slot);
+        check_list(env, err, list, number_of_elements - 1);
+    }
+
+    return found;
+}
+
+struct dc_compact_list_item dc_compact_list_remove_last_occurrence(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item)
+{
+    struct dc_compact_list_item found;
+    size_t number_of_elements;
+    uint32_t slot;
+    size_t index;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    slot = get_last_slot_with(env, list, item, &index);
+
+    if(slot == NIL)
+    {
+        found.index = -1;
+        found.data = NULL;
+    }
+    else
+    {
+        found.index = (ssize_t)index;
+        found.data = remove_slot(env, list, slot);
+        check_list(env, err, list, number_of_elements - 1);
+    }
+
+    return found;
+}
+
+size_t dc_compact_list_remove_all_occurrences(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, const void *item)
+{
+    struct occurrence occurrence;
+    size_t count;
+
+    DC_TRACE(env);
+    occurrence.comparator = list->comparator;
+    occurrence.item = item;
+    count = remove_matching(env, err, list, is_occurrence, &occurrence, true, NULL, NULL);
+
+    return count;
+}
+
+size_t dc_compact_list_remove_if(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state)
+{
+    size_t count;
+
+    DC_TRACE(env);
+    count = remove_matching(env, err, list, predicate, predicate_state, true, removed, removed_state);
+
+    return count;
+}
+
+size_t dc_compact_list_retain_if(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state)
+{
+    size_t count;
+
+    DC_TRACE(env);
+    count = remove_matching(env, err, list, predicate, predicate_state, false, removed, removed_state);
+
+    return count;
+}
+
+ssize_t dc_compact_list_index_of(const struct dc_env *env, const struct dc_compact_list *list, const void *item)
+{
+    size_t index;
+
+    DC_TRACE(env);
+
+    if(get_first_slot_with(env, list, item, &index) == NIL)
+    {
+        return -1;
+    }
+
+    return (ssize_t)index;
+}
+
+ssize_t dc_compact_list_last_index_of(const struct dc_env *env, const struct dc_compact_list *list, const void *item)
+{
+    size_t index;
+
+    DC_TRACE(env);
+
+    if(get_last_slot_with(env, list, item, &index) == NIL)
+    {
+        return -1;
+    }
+
+    return (ssize_t)index;
+}
+
+void dc_compact_list_to_array(const struct dc_env *env, const struct dc_compact_list *list, void *array, size_t count)
+{
+    void **items;
+    size_t index;
+
+    DC_TRACE(env);
+    items = array;
+    index = 0;
+
+    for(uint32_t slot = list->head; slot != NIL && index < count; slot = list->nodes[slot].next)
+    {
+        items[index] = (void *)(uintptr_t)list->nodes[slot].data;
+        index++;
+    }
+}
+
+void dc_compact_list_concat(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, struct dc_compact_list *other)
+{
+    size_t number_of_elements;
+    size_t count;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    count = other->number_of_elements;
+
+    if(list == other)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    // each list owns its node array, so the items are copied unless the whole array can change hands
+    if(number_of_elements == 0)
+    {
+        swap_nodes(env, list, other);
+    }
+    else if(count > 0 && !copy_slots(env, err, list, list->tail, other, other->head, count))
+    {
+        return;
+    }
+
+    dc_compact_list_clear(env, err, other);
+    check_list(env, err, list, number_of_elements + count);
+}
+
+void dc_compact_list_splice(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index, struct dc_compact_list *other, size_t from_index, size_t to_index)
+{
+    size_t number_of_elements;
+    size_t other_number_of_elements;
+    size_t count;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    other_number_of_elements = other->number_of_elements;
+
+    if(list == other || index > number_of_elements || from_index > to_index || to_index > other_number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    count = to_index - from_index;
+
+    if(count > 0)
+    {
+        uint32_t first;
+        uint32_t prev;
+
+        first = get_slot_at(env, other, from_index);
+        prev = (index == 0) ? NIL : get_slot_at(env, list, index - 1);
+
+        if(!copy_slots(env, err, list, prev, other, first, count))
+        {
+            return;
+        }
+
+        remove_slots(env, other, first, count);
+    }
+
+    check_list(env, err, other, other_number_of_elements - count);
+    check_list(env, err, list, number_of_elements + count);
+}
+
+struct dc_compact_list *dc_compact_list_split_at(const struct dc_env *env, struct dc_error *err, struct dc_compact_list *list, size_t index)
+{
+    size_t number_of_elements;
+    struct dc_compact_list *tail_list;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+
+    if(index > number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return NULL;
+    }
+
+    tail_list = dc_compact_list_create(env, err, list->comparator);
+
+    if(dc_error_has_no_error(err))
+    {
+        size_t count;
+
+        count = number_of_elements - index;
+
+        if(index == 0)
+        {
+            swap_nodes(env, list, tail_list);
+        }
+        else if(count > 0)
+        {
+            uint32_t first;
+
+            first = get_slot_at(env, list, index);
+
+            if(!copy_slots(env, err, tail_list, NIL, list, first, count))
+            {
+                dc_compact_list_destroy(env, err, tail_list);
+
+                return NULL;
+            }
+
+            remove_slots(env, list, first, count);
+        }
+
+        check_list(env, err, list, index);
+        check_list(env, err, tail_list, count);
+    }
+
+    return tail_list;
+}
+
+void dc_compact_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_compact_list *list, dc_visitor visitor, void *state)
+{
+    DC_TRACE(env);
+
+    for(uint32_t slot = list->head; slot != NIL; slot = list->nodes[slot].next)
+    {
+        visitor(env, err, list->nodes[slot].data, state);
+    }
+}
+
+size_t dc_compact_list_snapshot_size(const struct dc_env *env, const struct dc_compact_list *list)
+{
+    DC_TRACE(env);
+
+    return sizeof(struct snapshot_header) + ((size_t)list->used * sizeof(struct node));
+}
+
+void dc_compact_list_snapshot(const struct dc_env *env, const struct dc_compact_list *list, void *buffer)
+{
+    struct snapshot_header header;
+
+    DC_TRACE(env);
+    header.number_of_elements = list->number_of_elements;
+    header.used = list->used;
+    header.head = list->head;
+    header.tail = list->tail;
+    header.free_head = list->free_head;
+    dc_memcpy(env, buffer, &header, sizeof(header));
+
+    if(list->used > 0)
+    {
+        dc_memcpy(env, (char *)buffer + sizeof(header), list->nodes, (size_t)list->used * sizeof(struct node));
+    }
+}
+
+struct dc_compact_list *dc_compact_list_restore(const struct dc_env *env, struct dc_error *err, dc_comparator comparator, const void *buffer, size_t size)
+{
+    struct snapshot_header header;
+    struct dc_compact_list *list;
+
+    DC_TRACE(env);
+
+    if(size < sizeof(header))
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+
+        return NULL;
+    }
+
+    dc_memcpy(env, &header, buffer, sizeof(header));
+
+    // every index is checked before the nodes are touched, a snapshot may come from anywhere
+    if(size != sizeof(header) + ((size_t)header.used * sizeof(struct node)) || header.number_of_elements > header.used
+       || !is_valid_slot(env, header.head, header.used) || !is_valid_slot(env, header.tail, header.used) || !is_valid_slot(env, header.free_head, header.used)
+       || (header.head == NIL) != (header.number_of_elements == 0) || (header.tail == NIL) != (header.number_of_elements == 0))
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+
+        return NULL;
+    }
+
+    list = dc_compact_list_create(env, err, comparator);
+
+    if(dc_error_has_error(err))
+    {
+        return list;
+    }
+
+    if(!dc_compact_list_reserve(env, err, list, header.used))
+    {
+        dc_compact_list_destroy(env, err, list);
+
+        return NULL;
+    }
+
+    if(header.used > 0)
+    {
+        dc_memcpy(env, list->nodes, (const char *)buffer + sizeof(header), (size_t)header.used * sizeof(struct node));
+    }
+
+    if(!is_valid_chain(env, list->nodes, &header))
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        dc_compact_list_destroy(env, err, list);
+
+        return NULL;
+    }
+
+    list->number_of_elements = (size_t)header.number_of_elements;
+    list->used = header.used;
+    list->head = header.head;
+    list->tail = header.tail;
+    list->free_head = header.free_head;
+    check_list(env, err, list, (size_t)header.number_of_elements);
+
+    if(dc_error_has_error(err))
+    {
+        dc_compact_list_destroy(env, err, list);
+        list = NULL;
+    }
+
+    return list;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/hasher.h"
+#include <stdint.h>
+
+
+size_t dc_string_hasher(const struct dc_env *env, const void *item)
+{
+    const unsigned char *str;
+    uint64_t hash;
+
+    DC_TRACE(env);
+    str = item;
+
+    // 64-bit FNV-1a
+    hash = UINT64_C(14695981039346656037);
+
+    while(*str)
+    {
+        hash ^= *str;
+        hash *= UINT64_C(1099511628211);
+        str++;
+    }
+
+    return (size_t)hash;
+}
@@ -34,9 +34,19 @@ struct dc_linked_list
     struct node *tail;
 };
 
+struct occurrence
+{
+    dc_comparator comparator;
+    const void *item;
+};
+
 static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_linked_list *list, size_t number_of_elements);
 static struct node *get_node_at(const struct dc_env *env, const struct node *start, size_t index);
 static struct node *get_node_with(const struct dc_env *env, const struct node *start, void *item, dc_comparator comparator);
+static size_t remove_matching(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, dc_predicate predicate, void *predicate_state, bool remove_when, dc_visitor removed, void *removed_state);
+static bool is_occurrence(const struct dc_env *env, const void *item, void *state);
+static void unlink_chain(const struct dc_env *env, struct dc_linked_list *list, struct node *first, struct node *last, size_t count);
+static void link_chain(const struct dc_env *env, struct dc_linked_list *list, struct node *prev, struct node *first, struct node *last, size_t count);
 
 // NOLINTBEGIN(readability-function-cognitive-complexity)
 static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_linked_list *list, size_t number_of_elements)
@@ -111,7 +121,7 @@ static void check_list(const struct dc_env *env, struct dc_error *err, const str
                 return;
             }
 
-            if(list->head != list->tail)
+            if(list->head == list->tail)
             {
                 DC_ERROR_RAISE_SYSTEM(err, "", 11);
                 return;
@@ -173,6 +183,158 @@ static struct node *get_node_with(const struct dc_env *env, const struct node *s
     return tmp;
 }
 
+static size_t remove_matching(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, dc_predicate predicate, void *predicate_state, bool remove_when, dc_visitor removed, void *removed_state)
+{
+    size_t number_of_elements;
+    size_t count;
+    struct node *removed_head;
+    struct node *removed_tail;
+    struct node *tmp;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    count = 0;
+    removed_head = NULL;
+    removed_tail = NULL;
+    tmp = list->head;
+
+    // unlink the matches onto a detached chain so the list is only walked once
+    while(tmp)
+    {
+        struct node *next;
+
+        next = tmp->next;
+
+        if(predicate(env, tmp->data, predicate_state) == remove_when)
+        {
+            if(tmp->prev)
+            {
+                tmp->prev->next = next;
+            }
+            else
+            {
+                list->head = next;
+            }
+
+            if(next)
+            {
+                next->prev = tmp->prev;
+            }
+            else
+            {
+                list->tail = tmp->prev;
+            }
+
+            tmp->prev = removed_tail;
+            tmp->next = NULL;
+
+            if(removed_tail)
+            {
+                removed_tail->next = tmp;
+            }
+            else
+            {
+                removed_head = tmp;
+            }
+
+            removed_tail = tmp;
+            count++;
+        }
+
+        tmp = next;
+    }
+
+    list->number_of_elements -= count;
+    check_list(env, err, list, number_of_elements - count);
+
+    // hand the items back and free the nodes once the list is consistent again
+    for(tmp = removed_head; tmp;)
+    {
+        struct node *next;
+
+        next = tmp->next;
+
+        if(removed)
+        {
+            removed(env, err, tmp->data, removed_state);
+        }
+
+        dc_free(env, tmp);
+        tmp = next;
+    }
+
+    return count;
+}
+
+static bool is_occurrence(const struct dc_env *env, const void *item, void *state)
+{
+    const struct occurrence *occurrence;
+
+    DC_TRACE(env);
+    occurrence = state;
+
+    return occurrence->comparator(env, occurrence->item, item) == 0;
+}
+
+static void unlink_chain(const struct dc_env *env, struct dc_linked_list *list, struct node *first, struct node *last, size_t count)
+{
+    DC_TRACE(env);
+
+    if(first->prev)
+    {
+        first->prev->next = last->next;
+    }
+    else
+    {
+        list->head = last->next;
+    }
+
+    if(last->next)
+    {
+        last->next->prev = first->prev;
+    }
+    else
+    {
+        list->tail = first->prev;
+    }
+
+    first->prev = NULL;
+    last->next = NULL;
+    list->number_of_elements -= count;
+}
+
+static void link_chain(const struct dc_env *env, struct dc_linked_list *list, struct node *prev, struct node *first, struct node *last, size_t count)
+{
+    struct node *next;
+
+    DC_TRACE(env);
+
+    // insert first..last after prev, or at the head when prev is NULL
+    if(prev)
+    {
+        next = prev->next;
+        prev->next = first;
+    }
+    else
+    {
+        next = list->head;
+        list->head = first;
+    }
+
+    if(next)
+    {
+        next->prev = last;
+    }
+    else
+    {
+        list->tail = last;
+    }
+
+    first->prev = prev;
+    last->next = next;
+    list->number_of_elements += count;
+}
+
 struct dc_linked_list *dc_linked_list_create(const struct dc_env *env, struct dc_error *err, dc_comparator comparator)
 {
     struct dc_linked_list *list;
@@ -284,8 +446,17 @@ bool dc_linked_list_add_at(const struct dc_env *env, struct dc_error *err, struc
             if(index == 0)
             {
                 new_node->next = list->head;
+
+                if(list->head)
+                {
+                    list->head->prev = new_node;
+                }
+                else
+                {
+                    list->tail = new_node;
+                }
+
                 list->head = new_node;
-                list->tail = new_node;
             }
             else if(index == number_of_elements)
             {
@@ -485,12 +656,35 @@ struct dc_linked_list_item dc_linked_list_remove_last_occurrence(const struct dc
 
 size_t dc_linked_list_remove_all_occurrences(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, const void *item)
 {
-    size_t number_of_elements;
+    struct occurrence occurrence;
     size_t count;
 
     DC_TRACE(env);
-    number_of_elements = list->number_of_elements;
-    check_list(env, err, list, list->number_of_elements - count);
+    occurrence.comparator = list->comparator;
+    occurrence.item = item;
+    count = remove_matching(env, err, list, is_occurrence, &occurrence, true, NULL, NULL);
+
+    return count;
+}
+
+size_t dc_linked_list_remove_if(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state)
+{
+    size_t count;
+
+    DC_TRACE(env);
+    count = remove_matching(env, err, list, predicate, predicate_state, true, removed, removed_state);
+
+    return count;
+}
+
+size_t dc_linked_list_retain_if(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, dc_predicate predicate, void *predicate_state, dc_visitor removed, void *removed_state)
+{
+    size_t count;
+
+    DC_TRACE(env);
+    count = remove_matching(env, err, list, predicate, predicate_state, false, removed, removed_state);
+
+    return count;
 }
 
 ssize_t dc_linked_list_index_of(const struct dc_env *env, const struct dc_linked_list *list, const void *item)
@@ -508,6 +702,124 @@ void dc_linked_list_to_array(const struct dc_env *env, const struct dc_linked_li
     DC_TRACE(env);
 }
 
+void dc_linked_list_concat(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, struct dc_linked_list *other)
+{
+    size_t number_of_elements;
+    size_t count;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    count = other->number_of_elements;
+
+    if(list == other)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    if(count > 0)
+    {
+        struct node *first;
+        struct node *last;
+
+        first = other->head;
+        last = other->tail;
+        unlink_chain(env, other, first, last, count);
+        link_chain(env, list, list->tail, first, last, count);
+    }
+
+    check_list(env, err, other, 0);
+    check_list(env, err, list, number_of_elements + count);
+}
+
+void dc_linked_list_splice(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, size_t index, struct dc_linked_list *other, size_t from_index, size_t to_index)
+{
+    size_t number_of_elements;
+    size_t other_number_of_elements;
+    size_t count;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+    other_number_of_elements = other->number_of_elements;
+
+    if(list == other || index > number_of_elements || from_index > to_index || to_index > other_number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    count = to_index - from_index;
+
+    if(count > 0)
+    {
+        struct node *first;
+        struct node *last;
+        struct node *prev;
+
+        first = get_node_at(env, other->head, from_index);
+        last = get_node_at(env, first, count - 1);
+        unlink_chain(env, other, first, last, count);
+
+        if(index == number_of_elements)
+        {
+            prev = list->tail;
+        }
+        else if(index == 0)
+        {
+            prev = NULL;
+        }
+        else
+        {
+            prev = get_node_at(env, list->head, index - 1);
+        }
+
+        link_chain(env, list, prev, first, last, count);
+    }
+
+    check_list(env, err, other, other_number_of_elements - count);
+    check_list(env, err, list, number_of_elements + count);
+}
+
+struct dc_linked_list *dc_linked_list_split_at(const struct dc_env *env, struct dc_error *err, struct dc_linked_list *list, size_t index)
+{
+    size_t number_of_elements;
+    struct dc_linked_list *tail_list;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+
+    if(index > number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return NULL;
+    }
+
+    tail_list = dc_linked_list_create(env, err, list->comparator);
+
+    if(dc_error_has_no_error(err))
+    {
+        size_t count;
+
+        count = number_of_elements - index;
+
+        if(count > 0)
+        {
+            struct node *first;
+            struct node *last;
+
+            first = get_node_at(env, list->head, index);
+            last = list->tail;
+            unlink_chain(env, list, first, last, count);
+            link_chain(env, tail_list, NULL, first, last, count);
+        }
+
+        check_list(env, err, list, index);
+        check_list(env, err, tail_list, count);
+    }
+
+    return tail_list;
+}
+
 void dc_linked_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_linked_list *list, dc_visitor visitor, void *state)
 {
     struct node *tmp;
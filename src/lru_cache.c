@@ -0,0 +1,627 @@
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/lru_cache.h"
+#include <dc_c/dc_stdlib.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+
+
+struct entry
+{
+    const void *key;
+    const void *value;
+    size_t hash;
+    struct entry *prev;
+    struct entry *next;         // also links the free entries
+    struct entry *hash_next;
+};
+
+struct shard
+{
+    pthread_mutex_t mutex;
+    size_t capacity;
+    size_t number_of_entries;
+    struct entry *entries;
+    struct entry *free_entries;
+    struct entry **buckets;
+    size_t bucket_mask;
+    struct entry *head;         // most recently used
+    struct entry *tail;         // least recently used
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+};
+
+struct dc_lru_cache
+{
+    dc_hasher hasher;
+    dc_comparator comparator;
+    dc_lru_cache_evictor evictor;
+    void *evictor_state;
+    bool synchronized;
+    size_t capacity;
+    size_t number_of_shards;
+    struct shard *shards;
+};
+
+static size_t mix_hash(const struct dc_env *env, size_t hash);
+static struct shard *get_shard(const struct dc_env *env, const struct dc_lru_cache *cache, size_t hash);
+static void lock_shard(const struct dc_env *env, const struct dc_lru_cache *cache, struct shard *shard);
+static void unlock_shard(const struct dc_env *env, const struct dc_lru_cache *cache, struct shard *shard);
+static bool init_shard(const struct dc_env *env, struct dc_error *err, struct shard *shard, size_t capacity, bool synchronized);
+static void destroy_shard(const struct dc_env *env, struct shard *shard, bool synchronized);
+static void reset_shard(const struct dc_env *env, struct shard *shard);
+static void check_shard(const struct dc_env *env, struct dc_error *err, const struct shard *shard);
+static struct entry *find_entry(const struct dc_env *env, const struct dc_lru_cache *cache, const struct shard *shard, const void *key, size_t hash);
+static void unlink_entry(const struct dc_env *env, struct shard *shard, struct entry *entry);
+static void push_front(const struct dc_env *env, struct shard *shard, struct entry *entry);
+static void add_to_index(const struct dc_env *env, struct shard *shard, struct entry *entry);
+static void remove_from_index(const struct dc_env *env, struct shard *shard, const struct entry *entry);
+
+static size_t mix_hash(const struct dc_env *env, size_t hash)
+{
+    uint64_t bits;
+
+    DC_TRACE(env);
+
+    // user hashers are often weak in the low bits, and both the shard and the bucket come from this
+    bits = hash;
+    bits ^= bits >> 33U;
+    bits *= UINT64_C(0xFF51AFD7ED558CCD);
+    bits ^= bits >> 33U;
+
+    return (size_t)bits;
+}
+
+static struct shard *get_shard(const struct dc_env *env, const struct dc_lru_cache *cache, size_t hash)
+{
+    size_t index;
+
+    DC_TRACE(env);
+    index = 0;
+
+    if(cache->number_of_shards > 1)
+    {
+        // buckets use the low bits, so pick the shard from the high ones
+        index = (hash >> (sizeof(size_t) * CHAR_BIT / 2)) % cache->number_of_shards;
+    }
+
+    return &cache->shards[index];
+}
+
+static void lock_shard(const struct dc_env *env, const struct dc_lru_cache *cache, struct shard *shard)
+{
+    DC_TRACE(env);
+
+    if(cache->synchronized)
+    {
+        pthread_mutex_lock(&shard->mutex);
+    }
+}
+
+static void unlock_shard(const struct dc_env *env, const struct dc_lru_cache *cache, struct shard *shard)
+{
+    DC_TRACE(env);
+
+    if(cache->synchronized)
+    {
+        pthread_mutex_unlock(&shard->mutex);
+    }
+}
+
+static bool init_shard(const struct dc_env *env, struct dc_error *err, struct shard *shard, size_t capacity, bool synchronized)
+{
+    size_t number_of_buckets;
+
+    DC_TRACE(env);
+    number_of_buckets = 1;
+
+    while(number_of_buckets < capacity)
+    {
+        number_of_buckets <<= 1U;
+    }
+
+    shard->capacity = capacity;
+    shard->bucket_mask = number_of_buckets - 1;
+
+    // the capacity is fixed, so every entry is allocated up front and a put never allocates
+    shard->entries = dc_calloc(env, err, capacity, sizeof(struct entry));
+
+    if(dc_error_has_error(err))
+    {
+        return false;
+    }
+
+    shard->buckets = dc_calloc(env, err, number_of_buckets, sizeof(struct entry *));
+
+    if(dc_error_has_error(err))
+    {
+        dc_free(env, shard->entries);
+
+        return false;
+    }
+
+    if(synchronized)
+    {
+        int result;
+
+        result = pthread_mutex_init(&shard->mutex, NULL);
+
+        if(result != 0)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", result);
+            dc_free(env, shard->buckets);
+            dc_free(env, shard->entries);
+
+            return false;
+        }
+    }
+
+    reset_shard(env, shard);
+
+    return true;
+}
+
+static void destroy_shard(const struct dc_env *env, struct shard *shard, bool synchronized)
+{
+    DC_TRACE(env);
+
+    if(synchronized)
+    {
+        pthread_mutex_destroy(&shard->mutex);
+    }
+
+    dc_free(env, shard->buckets);
+    dc_free(env, shard->entries);
+}
+
+static void reset_shard(const struct dc_env *env, struct shard *shard)
+{
+    DC_TRACE(env);
+
+    for(size_t i = 0; i <= shard->bucket_mask; i++)
+    {
+        shard->buckets[i] = NULL;
+    }
+
+    shard->free_entries = NULL;
+
+    for(size_t i = shard->capacity; i > 0; i--)
+    {
+        shard->entries[i - 1].next = shard->free_entries;
+        shard->free_entries = &shard->entries[i - 1];
+    }
+
+    shard->number_of_entries = 0;
+    shard->head = NULL;
+    shard->tail = NULL;
+}
+
+static void check_shard(const struct dc_env *env, struct dc_error *err, const struct shard *shard)
+{
+    DC_TRACE(env);
+
+    if(shard->number_of_entries > shard->capacity)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    if((shard->head == NULL) != (shard->number_of_entries == 0) || (shard->tail == NULL) != (shard->number_of_entries == 0))
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 2);
+        return;
+    }
+}
+
+static struct entry *find_entry(const struct dc_env *env, const struct dc_lru_cache *cache, const struct shard *shard, const void *key, size_t hash)
+{
+    struct entry *entry;
+
+    DC_TRACE(env);
+
+    for(entry = shard->buckets[hash & shard->bucket_mask]; entry; entry = entry->hash_next)
+    {
+        if(entry->hash == hash && cache->comparator(env, key, entry->key) == 0)
+        {
+            break;
+        }
+    }
+
+    return entry;
+}
+
+static void unlink_entry(const struct dc_env *env, struct shard *shard, struct entry *entry)
+{
+    DC_TRACE(env);
+
+    if(entry->prev)
+    {
+        entry->prev->next = entry->next;
+    }
+    else
+    {
+        shard->head = entry->next;
+    }
+
+    if(entry->next)
+    {
+        entry->next->prev = entry->prev;
+    }
+    else
+    {
+        shard->tail = entry->prev;
+    }
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void push_front(const struct dc_env *env, struct shard *shard, struct entry *entry)
+{
+    DC_TRACE(env);
+    entry->prev = NULL;
+    entry->next = shard->head;
+
+    if(shard->head)
+    {
+        shard->head->prev = entry;
+    }
+    else
+    {
+        shard->tail = entry;
+    }
+
+    shard->head = entry;
+}
+
+static void add_to_index(const struct dc_env *env, struct shard *shard, struct entry *entry)
+{
+    struct entry **bucket;
+
+    DC_TRACE(env);
+    bucket = &shard->buckets[entry->hash & shard->bucket_mask];
+    entry->hash_next = *bucket;
+    *bucket = entry;
+}
+
+static void remove_from_index(const struct dc_env *env, struct shard *shard, const struct entry *entry)
+{
+    struct entry **link;
+
+    DC_TRACE(env);
+
+    for(link = &shard->buckets[entry->hash & shard->bucket_mask]; *link != entry; link = &(*link)->hash_next)
+    {
+    }
+
+    *link = entry->hash_next;
+}
+
+struct dc_lru_cache *dc_lru_cache_create(const struct dc_env *env, struct dc_error *err, size_t capacity, size_t number_of_shards, dc_hasher hasher, dc_comparator comparator, dc_lru_cache_evictor evictor, void *evictor_state)
+{
+    struct dc_lru_cache *cache;
+    size_t shard_count;
+
+    DC_TRACE(env);
+    shard_count = number_of_shards == 0 ? 1 : number_of_shards;
+
+    if(capacity < shard_count || hasher == NULL || comparator == NULL)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+
+        return NULL;
+    }
+
+    cache = dc_calloc(env, err, 1, sizeof(struct dc_lru_cache));
+
+    if(dc_error_has_error(err))
+    {
+        return NULL;
+    }
+
+    cache->shards = dc_calloc(env, err, shard_count, sizeof(struct shard));
+
+    if(dc_error_has_error(err))
+    {
+        dc_free(env, cache);
+
+        return NULL;
+    }
+
+    cache->hasher = hasher;
+    cache->comparator = comparator;
+    cache->evictor = evictor;
+    cache->evictor_state = evictor_state;
+    cache->synchronized = number_of_shards > 0;
+    cache->capacity = capacity;
+    cache->number_of_shards = shard_count;
+
+    for(size_t i = 0; i < shard_count; i++)
+    {
+        size_t shard_capacity;
+
+        // spread the remainder over the first shards
+        shard_capacity = (capacity / shard_count) + (i < capacity % shard_count ? 1 : 0);
+
+        if(!init_shard(env, err, &cache->shards[i], shard_capacity, cache->synchronized))
+        {
+            for(size_t j = 0; j < i; j++)
+            {
+                destroy_shard(env, &cache->shards[j], cache->synchronized);
+            }
+
+            dc_free(env, cache->shards);
+            dc_free(env, cache);
+
+            return NULL;
+        }
+    }
+
+    return cache;
+}
+
+void dc_lru_cache_destroy(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache)
+{
+    DC_TRACE(env);
+
+    for(size_t i = 0; i < cache->number_of_shards; i++)
+    {
+        check_shard(env, err, &cache->shards[i]);
+        destroy_shard(env, &cache->shards[i], cache->synchronized);
+    }
+
+    dc_free(env, cache->shards);
+    dc_free(env, cache);
+}
+
+size_t dc_lru_cache_size(const struct dc_env *env, struct dc_lru_cache *cache)
+{
+    size_t size;
+
+    DC_TRACE(env);
+    size = 0;
+
+    for(size_t i = 0; i < cache->number_of_shards; i++)
+    {
+        lock_shard(env, cache, &cache->shards[i]);
+        size += cache->shards[i].number_of_entries;
+        unlock_shard(env, cache, &cache->shards[i]);
+    }
+
+    return size;
+}
+
+size_t dc_lru_cache_capacity(const struct dc_env *env, const struct dc_lru_cache *cache)
+{
+    DC_TRACE(env);
+
+    return cache->capacity;
+}
+
+void dc_lru_cache_clear(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache)
+{
+    DC_TRACE(env);
+
+    for(size_t i = 0; i < cache->number_of_shards; i++)
+    {
+        lock_shard(env, cache, &cache->shards[i]);
+        reset_shard(env, &cache->shards[i]);
+        check_shard(env, err, &cache->shards[i]);
+        unlock_shard(env, cache, &cache->shards[i]);
+    }
+}
+
+void *dc_lru_cache_get(const struct dc_env *env, struct dc_lru_cache *cache, const void *key)
+{
+    struct shard *shard;
+    struct entry *entry;
+    size_t hash;
+    void *value;
+
+    DC_TRACE(env);
+    hash = mix_hash(env, cache->hasher(env, key));
+    shard = get_shard(env, cache, hash);
+    value = NULL;
+    lock_shard(env, cache, shard);
+    entry = find_entry(env, cache, shard, key, hash);
+
+    if(entry)
+    {
+        shard->hits++;
+        value = (void *)(uintptr_t)entry->value;
+
+        if(shard->head != entry)
+        {
+            unlink_entry(env, shard, entry);
+            push_front(env, shard, entry);
+        }
+    }
+    else
+    {
+        shard->misses++;
+    }
+
+    unlock_shard(env, cache, shard);
+
+    return value;
+}
+
+void *dc_lru_cache_peek(const struct dc_env *env, struct dc_lru_cache *cache, const void *key)
+{
+    struct shard *shard;
+    struct entry *entry;
+    size_t hash;
+    void *value;
+
+    DC_TRACE(env);
+    hash = mix_hash(env, cache->hasher(env, key));
+    shard = get_shard(env, cache, hash);
+    lock_shard(env, cache, shard);
+    entry = find_entry(env, cache, shard, key, hash);
+    value = entry ? (void *)(uintptr_t)entry->value : NULL;
+    unlock_shard(env, cache, shard);
+
+    return value;
+}
+
+bool dc_lru_cache_move_to_front(const struct dc_env *env, struct dc_lru_cache *cache, const void *key)
+{
+    struct shard *shard;
+    struct entry *entry;
+    size_t hash;
+
+    DC_TRACE(env);
+    hash = mix_hash(env, cache->hasher(env, key));
+    shard = get_shard(env, cache, hash);
+    lock_shard(env, cache, shard);
+    entry = find_entry(env, cache, shard, key, hash);
+
+    if(entry && shard->head != entry)
+    {
+        unlink_entry(env, shard, entry);
+        push_front(env, shard, entry);
+    }
+
+    unlock_shard(env, cache, shard);
+
+    return entry != NULL;
+}
+
+void *dc_lru_cache_put(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache, const void *key, const void *value)
+{
+    struct shard *shard;
+    struct entry *entry;
+    size_t hash;
+    void *old_value;
+    bool evicted;
+    const void *evicted_key;
+    void *evicted_value;
+
+    DC_TRACE(env);
+    hash = mix_hash(env, cache->hasher(env, key));
+    shard = get_shard(env, cache, hash);
+    old_value = NULL;
+    evicted = false;
+    evicted_key = NULL;
+    evicted_value = NULL;
+    lock_shard(env, cache, shard);
+    entry = find_entry(env, cache, shard, key, hash);
+
+    if(entry)
+    {
+        old_value = (void *)(uintptr_t)entry->value;
+        entry->value = value;
+
+        if(shard->head != entry)
+        {
+            unlink_entry(env, shard, entry);
+            push_front(env, shard, entry);
+        }
+    }
+    else
+    {
+        if(shard->free_entries)
+        {
+            entry = shard->free_entries;
+            shard->free_entries = entry->next;
+            shard->number_of_entries++;
+        }
+        else
+        {
+            // full, so the least recently used entry makes room and its slot is reused
+            entry = shard->tail;
+            evicted = true;
+            evicted_key = entry->key;
+            evicted_value = (void *)(uintptr_t)entry->value;
+            shard->evictions++;
+            unlink_entry(env, shard, entry);
+            remove_from_index(env, shard, entry);
+        }
+
+        entry->key = key;
+        entry->value = value;
+        entry->hash = hash;
+        add_to_index(env, shard, entry);
+        push_front(env, shard, entry);
+    }
+
+    check_shard(env, err, shard);
+    unlock_shard(env, cache, shard);
+
+    if(evicted && cache->evictor)
+    {
+        cache->evictor(env, err, evicted_key, evicted_value, cache->evictor_state);
+    }
+
+    return old_value;
+}
+
+void *dc_lru_cache_remove(const struct dc_env *env, struct dc_error *err, struct dc_lru_cache *cache, const void *key)
+{
+    struct shard *shard;
+    struct entry *entry;
+    size_t hash;
+    void *value;
+
+    DC_TRACE(env);
+    hash = mix_hash(env, cache->hasher(env, key));
+    shard = get_shard(env, cache, hash);
+    value = NULL;
+    lock_shard(env, cache, shard);
+    entry = find_entry(env, cache, shard, key, hash);
+
+    if(entry)
+    {
+        value = (void *)(uintptr_t)entry->value;
+        unlink_entry(env, shard, entry);
+        remove_from_index(env, shard, entry);
+        entry->key = NULL;
+        entry->value = NULL;
+        entry->next = shard->free_entries;
+        shard->free_entries = entry;
+        shard->number_of_entries--;
+    }
+
+    check_shard(env, err, shard);
+    unlock_shard(env, cache, shard);
+
+    return value;
+}
+
+struct dc_lru_cache_stats dc_lru_cache_get_stats(const struct dc_env *env, struct dc_lru_cache *cache)
+{
+    struct dc_lru_cache_stats stats;
+
+    DC_TRACE(env);
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+
+    for(size_t i = 0; i < cache->number_of_shards; i++)
+    {
+        lock_shard(env, cache, &cache->shards[i]);
+        stats.hits += cache->shards[i].hits;
+        stats.misses += cache->shards[i].misses;
+        stats.evictions += cache->shards[i].evictions;
+        unlock_shard(env, cache, &cache->shards[i]);
+    }
+
+    return stats;
+}
@@ -0,0 +1,1163 @@
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/radix_tree.h"
+#include <dc_c/dc_stdlib.h>
+#include <dc_c/dc_string.h>
+#include <stdint.h>
+
+
+// ordered so that type + 1 is always the next size up
+enum node_type
+{
+    NODE_LEAF,
+    NODE_4,
+    NODE_16,
+    NODE_48,
+    NODE_256,
+};
+
+// a node holds the compressed path leading to it and, when a stored string ends there, that string
+struct node
+{
+    enum node_type type;
+    uint16_t number_of_children;
+    bool owns_prefix;           // otherwise the prefix points into key, which holds the same bytes
+    size_t prefix_length;
+    const char *prefix;
+    const char *key;
+};
+
+struct node4
+{
+    struct node header;
+    unsigned char keys[4];
+    struct node *children[4];
+};
+
+struct node16
+{
+    struct node header;
+    unsigned char keys[16];
+    struct node *children[16];
+};
+
+struct node48
+{
+    struct node header;
+    unsigned char child_index[256];    // slot + 1, 0 when there is no child for the byte
+    struct node *children[48];
+};
+
+struct node256
+{
+    struct node header;
+    struct node *children[256];
+};
+
+struct dc_radix_tree
+{
+    size_t number_of_elements;
+    struct node *root;
+};
+
+static void check_tree(const struct dc_env *env, struct dc_error *err, const struct dc_radix_tree *tree, size_t number_of_elements);
+static size_t node_capacity(const struct dc_env *env, enum node_type type);
+static struct node *create_node(const struct dc_env *env, struct dc_error *err, enum node_type type, const char *prefix, size_t prefix_length);
+static struct node *create_leaf(const struct dc_env *env, struct dc_error *err, const char *key, size_t depth);
+static bool own_prefix(const struct dc_env *env, struct dc_error *err, struct node *node);
+static void destroy_node(const struct dc_env *env, struct node *node);
+static void destroy_subtree(const struct dc_env *env, struct node *node);
+static struct node **find_child(const struct dc_env *env, struct node *node, unsigned char byte);
+static struct node *next_child(const struct dc_env *env, const struct node *node, size_t *cursor, unsigned char *byte);
+static void insert_child(const struct dc_env *env, struct node *node, unsigned char byte, struct node *child);
+static void delete_child(const struct dc_env *env, struct node *node, unsigned char byte);
+static bool resize_node(const struct dc_env *env, struct dc_error *err, struct node **node_ref, enum node_type type);
+static bool add_child(const struct dc_env *env, struct dc_error *err, struct node **node_ref, unsigned char byte, struct node *child);
+static void remove_child(const struct dc_env *env, struct dc_error *err, struct node **node_ref, unsigned char byte);
+static void collapse_node(const struct dc_env *env, struct dc_error *err, struct node **node_ref);
+static size_t match_prefix(const struct dc_env *env, const struct node *node, const char *key, size_t depth);
+static bool insert_key(const struct dc_env *env, struct dc_error *err, struct node **node_ref, const char *key, size_t depth);
+static const char *remove_key(const struct dc_env *env, struct dc_error *err, struct node **node_ref, const char *key, size_t depth);
+static void visit_subtree(const struct dc_env *env, struct dc_error *err, const struct node *node, dc_visitor visitor, void *state);
+
+static void check_tree(const struct dc_env *env, struct dc_error *err, const struct dc_radix_tree *tree, size_t number_of_elements)
+{
+    DC_TRACE(env);
+
+    if(tree->number_of_elements != number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    // empty nodes are always collapsed away, so only an empty tree has no root
+    if((tree->number_of_elements == 0) != (tree->root == NULL))
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 2);
+        return;
+    }
+}
+
+static size_t node_capacity(const struct dc_env *env, enum node_type type)
+{
+    size_t capacity;
+
+    DC_TRACE(env);
+
+    switch(type)
+    {
+        case NODE_LEAF:
+        {
+            capacity = 0;
+            break;
+        }
+        case NODE_4:
+        {
+            capacity = 4;
+            break;
+        }
+        case NODE_16:
+        {
+            capacity = 16;
+            break;
+        }
+        case NODE_48:
+        {
+            capacity = 48;
+            break;
+        }
+        case NODE_256:
+        default:
+        {
+            capacity = 256;
+            break;
+        }
+    }
+
+    return capacity;
+}
+
+static struct node *create_node(const struct dc_env *env, struct dc_error *err, enum node_type type, const char *prefix, size_t prefix_length)
+{
+    struct node *node;
+    size_t size;
+
+    DC_TRACE(env);
+
+    switch(type)
+    {
+        case NODE_LEAF:
+        {
+            size = sizeof(struct node);
+            break;
+        }
+        case NODE_4:
+        {
+            size = sizeof(struct node4);
+            break;
+        }
+        case NODE_16:
+        {
+            size = sizeof(struct node16);
+            break;
+        }
+        case NODE_48:
+        {
+            size = sizeof(struct node48);
+            break;
+        }
+        case NODE_256:
+        default:
+        {
+            size = sizeof(struct node256);
+            break;
+        }
+    }
+
+    node = dc_calloc(env, err, 1, size);
+
+    if(dc_error_has_error(err))
+    {
+        return NULL;
+    }
+
+    node->type = type;
+
+    if(prefix_length > 0)
+    {
+        char *copy;
+
+        copy = dc_malloc(env, err, prefix_length);
+
+        if(dc_error_has_error(err))
+        {
+            dc_free(env, node);
+
+            return NULL;
+        }
+
+        dc_memcpy(env, copy, prefix, prefix_length);
+        node->prefix = copy;
+        node->prefix_length = prefix_length;
+        node->owns_prefix = true;
+    }
+
+    return node;
+}
+
+static struct node *create_leaf(const struct dc_env *env, struct dc_error *err, const char *key, size_t depth)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    node = create_node(env, err, NODE_LEAF, NULL, 0);
+
+    // the rest of the key is the prefix, so a leaf costs one allocation and no copy
+    if(node)
+    {
+        node->prefix = &key[depth];
+        node->prefix_length = dc_strlen(env, &key[depth]);
+        node->key = key;
+    }
+
+    return node;
+}
+
+static bool own_prefix(const struct dc_env *env, struct dc_error *err, struct node *node)
+{
+    char *copy;
+
+    DC_TRACE(env);
+
+    if(node->owns_prefix || node->prefix_length == 0)
+    {
+        return true;
+    }
+
+    copy = dc_malloc(env, err, node->prefix_length);
+
+    if(dc_error_has_error(err))
+    {
+        return false;
+    }
+
+    dc_memcpy(env, copy, node->prefix, node->prefix_length);
+    node->prefix = copy;
+    node->owns_prefix = true;
+
+    return true;
+}
+
+static void destroy_node(const struct dc_env *env, struct node *node)
+{
+    DC_TRACE(env);
+
+    if(node->owns_prefix)
+    {
+        dc_free(env, (char *)(uintptr_t)node->prefix);
+    }
+
+    dc_free(env, node);
+}
+
+static void destroy_subtree(const struct dc_env *env, struct node *node)
+{
+    struct node *child;
+    size_t cursor;
+
+    DC_TRACE(env);
+    cursor = 0;
+
+    while((child = next_child(env, node, &cursor, NULL)) != NULL)
+    {
+        destroy_subtree(env, child);
+    }
+
+    destroy_node(env, node);
+}
+
+static struct node **find_child(const struct dc_env *env, struct node *node, unsigned char byte)
+{
+    DC_TRACE(env);
+
+    switch(node->type)
+    {
+        case NODE_LEAF:
+        {
+            break;
+        }
+        case NODE_4:
+        {
+            struct node4 *node4;
+
+            node4 = (struct node4 *)node;
+
+            for(uint16_t i = 0; i < node->number_of_children; i++)
+            {
+                if(node4->keys[i] == byte)
+                {
+                    return &node4->children[i];
+                }
+            }
+
+            break;
+        }
+        case NODE_16:
+        {
+            struct node16 *node16;
+
+            node16 = (struct node16 *)node;
+
+            // keys are sorted, so stop as soon as the byte has been passed
+            for(uint16_t i = 0; i < node->number_of_children && node16->keys[i] <= byte; i++)
+            {
+                if(node16->keys[i] == byte)
+                {
+                    return &node16->children[i];
+                }
+            }
+
+            break;
+        }
+        case NODE_48:
+        {
+            struct node48 *node48;
+
+            node48 = (struct node48 *)node;
+
+            if(node48->child_index[byte] != 0)
+            {
+                return &node48->children[node48->child_index[byte] - 1];
+            }
+
+            break;
+        }
+        case NODE_256:
+        default:
+        {
+            struct node256 *node256;
+
+            node256 = (struct node256 *)node;
+
+            if(node256->children[byte] != NULL)
+            {
+                return &node256->children[byte];
+            }
+
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static struct node *next_child(const struct dc_env *env, const struct node *node, size_t *cursor, unsigned char *byte)
+{
+    struct node *child;
+
+    DC_TRACE(env);
+    child = NULL;
+
+    switch(node->type)
+    {
+        case NODE_LEAF:
+        {
+            break;
+        }
+        case NODE_4:
+        case NODE_16:
+        {
+            const unsigned char *keys;
+            struct node *const *children;
+
+            if(node->type == NODE_4)
+            {
+                keys = ((const struct node4 *)node)->keys;
+                children = ((const struct node4 *)node)->children;
+            }
+            else
+            {
+                keys = ((const struct node16 *)node)->keys;
+                children = ((const struct node16 *)node)->children;
+            }
+
+            if(*cursor < node->number_of_children)
+            {
+                if(byte)
+                {
+                    *byte = keys[*cursor];
+                }
+
+                child = children[*cursor];
+                (*cursor)++;
+            }
+
+            break;
+        }
+        case NODE_48:
+        {
+            const struct node48 *node48;
+
+            node48 = (const struct node48 *)node;
+
+            for(; *cursor < 256 && child == NULL; (*cursor)++)
+            {
+                if(node48->child_index[*cursor] != 0)
+                {
+                    if(byte)
+                    {
+                        *byte = (unsigned char)*cursor;
+                    }
+
+                    child = node48->children[node48->child_index[*cursor] - 1];
+                }
+            }
+
+            break;
+        }
+        case NODE_256:
+        default:
+        {
+            const struct node256 *node256;
+
+            node256 = (const struct node256 *)node;
+
+            for(; *cursor < 256 && child == NULL; (*cursor)++)
+            {
+                if(node256->children[*cursor] != NULL)
+                {
+                    if(byte)
+                    {
+                        *byte = (unsigned char)*cursor;
+                    }
+
+                    child = node256->children[*cursor];
+                }
+            }
+
+            break;
+        }
+    }
+
+    return child;
+}
+
+// the caller makes sure there is room for the child, so this is never a leaf
+static void insert_child(const struct dc_env *env, struct node *node, unsigned char byte, struct node *child)
+{
+    DC_TRACE(env);
+
+    switch(node->type)
+    {
+        case NODE_LEAF:
+        {
+            return;
+        }
+        case NODE_4:
+        case NODE_16:
+        {
+            unsigned char *keys;
+            struct node **children;
+            uint16_t position;
+
+            if(node->type == NODE_4)
+            {
+                keys = ((struct node4 *)node)->keys;
+                children = ((struct node4 *)node)->children;
+            }
+            else
+            {
+                keys = ((struct node16 *)node)->keys;
+                children = ((struct node16 *)node)->children;
+            }
+
+            for(position = node->number_of_children; position > 0 && keys[position - 1] > byte; position--)
+            {
+                keys[position] = keys[position - 1];
+                children[position] = children[position - 1];
+            }
+
+            keys[position] = byte;
+            children[position] = child;
+            break;
+        }
+        case NODE_48:
+        {
+            struct node48 *node48;
+            unsigned char slot;
+
+            node48 = (struct node48 *)node;
+
+            // removals leave holes, so look for a free slot rather than appending
+            for(slot = 0; node48->children[slot] != NULL; slot++)
+            {
+            }
+
+            node48->children[slot] = child;
+            node48->child_index[byte] = (unsigned char)(slot + 1);
+            break;
+        }
+        case NODE_256:
+        default:
+        {
+            ((struct node256 *)node)->children[byte] = child;
+            break;
+        }
+    }
+
+    node->number_of_children++;
+}
+
+static void delete_child(const struct dc_env *env, struct node *node, unsigned char byte)
+{
+    DC_TRACE(env);
+
+    switch(node->type)
+    {
+        case NODE_LEAF:
+        {
+            return;
+        }
+        case NODE_4:
+        case NODE_16:
+        {
+            unsigned char *keys;
+            struct node **children;
+            uint16_t position;
+
+            if(node->type == NODE_4)
+            {
+                keys = ((struct node4 *)node)->keys;
+                children = ((struct node4 *)node)->children;
+            }
+            else
+            {
+                keys = ((struct node16 *)node)->keys;
+                children = ((struct node16 *)node)->children;
+            }
+
+            for(position = 0; keys[position] != byte; position++)
+            {
+            }
+
+            for(; position + 1 < node->number_of_children; position++)
+            {
+                keys[position] = keys[position + 1];
+                children[position] = children[position + 1];
+            }
+
+            break;
+        }
+        case NODE_48:
+        {
+            struct node48 *node48;
+
+            node48 = (struct node48 *)node;
+            node48->children[node48->child_index[byte] - 1] = NULL;
+            node48->child_index[byte] = 0;
+            break;
+        }
+        case NODE_256:
+        default:
+        {
+            ((struct node256 *)node)->children[byte] = NULL;
+            break;
+        }
+    }
+
+    node->number_of_children--;
+}
+
+static bool resize_node(const struct dc_env *env, struct dc_error *err, struct node **node_ref, enum node_type type)
+{
+    struct node *old_node;
+    struct node *new_node;
+    struct node *child;
+    unsigned char byte;
+    size_t cursor;
+
+    DC_TRACE(env);
+    old_node = *node_ref;
+    new_node = create_node(env, err, type, NULL, 0);
+
+    if(new_node == NULL)
+    {
+        return false;
+    }
+
+    // the prefix buffer changes hands rather than being copied
+    new_node->prefix = old_node->prefix;
+    new_node->prefix_length = old_node->prefix_length;
+    new_node->owns_prefix = old_node->owns_prefix;
+    new_node->key = old_node->key;
+    cursor = 0;
+
+    while((child = next_child(env, old_node, &cursor, &byte)) != NULL)
+    {
+        insert_child(env, new_node, byte, child);
+    }
+
+    dc_free(env, old_node);
+    *node_ref = new_node;
+
+    return true;
+}
+
+static bool add_child(const struct dc_env *env, struct dc_error *err, struct node **node_ref, unsigned char byte, struct node *child)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    node = *node_ref;
+
+    if(node->number_of_children == node_capacity(env, node->type))
+    {
+        if(!resize_node(env, err, node_ref, (enum node_type)(node->type + 1)))
+        {
+            return false;
+        }
+
+        node = *node_ref;
+    }
+
+    insert_child(env, node, byte, child);
+
+    return true;
+}
+
+static void remove_child(const struct dc_env *env, struct dc_error *err, struct node **node_ref, unsigned char byte)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    node = *node_ref;
+    delete_child(env, node, byte);
+
+    // shrink with some slack below the next size down so a node does not flip back and forth
+    switch(node->type)
+    {
+        case NODE_4:
+        {
+            if(node->number_of_children == 0)
+            {
+                resize_node(env, err, node_ref, NODE_LEAF);
+            }
+
+            break;
+        }
+        case NODE_16:
+        {
+            if(node->number_of_children <= 3)
+            {
+                resize_node(env, err, node_ref, NODE_4);
+            }
+
+            break;
+        }
+        case NODE_48:
+        {
+            if(node->number_of_children <= 12)
+            {
+                resize_node(env, err, node_ref, NODE_16);
+            }
+
+            break;
+        }
+        case NODE_256:
+        {
+            if(node->number_of_children <= 40)
+            {
+                resize_node(env, err, node_ref, NODE_48);
+            }
+
+            break;
+        }
+        case NODE_LEAF:
+        default:
+        {
+            break;
+        }
+    }
+}
+
+static void collapse_node(const struct dc_env *env, struct dc_error *err, struct node **node_ref)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    node = *node_ref;
+
+    if(node->key != NULL)
+    {
+        return;
+    }
+
+    if(node->number_of_children == 0)
+    {
+        destroy_node(env, node);
+        *node_ref = NULL;
+    }
+    else if(node->number_of_children == 1)
+    {
+        struct node *child;
+        unsigned char byte;
+        size_t cursor;
+        size_t prefix_length;
+
+        // fold the node into its only child: node prefix + edge byte + child prefix
+        cursor = 0;
+        child = next_child(env, node, &cursor, &byte);
+        prefix_length = node->prefix_length + 1 + child->prefix_length;
+
+        if(child->key != NULL)
+        {
+            // the child's key ends at the child and runs through the node, so it already holds the longer prefix
+            if(child->owns_prefix)
+            {
+                dc_free(env, (char *)(uintptr_t)child->prefix);
+            }
+
+            child->prefix = &child->key[dc_strlen(env, child->key) - prefix_length];
+            child->owns_prefix = false;
+        }
+        else
+        {
+            char *prefix;
+
+            prefix = dc_malloc(env, err, prefix_length);
+
+            if(dc_error_has_error(err))
+            {
+                return;
+            }
+
+            if(node->prefix_length > 0)
+            {
+                dc_memcpy(env, prefix, node->prefix, node->prefix_length);
+            }
+
+            prefix[node->prefix_length] = (char)byte;
+
+            if(child->prefix_length > 0)
+            {
+                dc_memcpy(env, &prefix[node->prefix_length + 1], child->prefix, child->prefix_length);
+            }
+
+            if(child->owns_prefix)
+            {
+                dc_free(env, (char *)(uintptr_t)child->prefix);
+            }
+
+            child->prefix = prefix;
+            child->owns_prefix = true;
+        }
+
+        child->prefix_length = prefix_length;
+        destroy_node(env, node);
+        *node_ref = child;
+    }
+}
+
+static size_t match_prefix(const struct dc_env *env, const struct node *node, const char *key, size_t depth)
+{
+    size_t matched;
+
+    DC_TRACE(env);
+
+    // the prefix never holds a NUL, so the end of the key stops the match too
+    for(matched = 0; matched < node->prefix_length && node->prefix[matched] == key[depth + matched]; matched++)
+    {
+    }
+
+    return matched;
+}
+
+static bool insert_key(const struct dc_env *env, struct dc_error *err, struct node **node_ref, const char *key, size_t depth)
+{
+    struct node *node;
+    struct node **child_ref;
+    struct node *leaf;
+    size_t matched;
+    unsigned char byte;
+
+    DC_TRACE(env);
+    node = *node_ref;
+
+    if(node == NULL)
+    {
+        leaf = create_leaf(env, err, key, depth);
+
+        if(leaf == NULL)
+        {
+            return false;
+        }
+
+        *node_ref = leaf;
+
+        return true;
+    }
+
+    matched = match_prefix(env, node, key, depth);
+
+    if(matched < node->prefix_length)
+    {
+        struct node *split;
+
+        // the key leaves the compressed path part way through, split the path at that point
+        split = create_node(env, err, NODE_4, node->prefix, matched);
+
+        if(split == NULL)
+        {
+            return false;
+        }
+
+        leaf = NULL;
+
+        if(key[depth + matched] != '\0')
+        {
+            leaf = create_leaf(env, err, key, depth + matched + 1);
+
+            if(leaf == NULL)
+            {
+                destroy_node(env, split);
+
+                return false;
+            }
+        }
+
+        byte = (unsigned char)node->prefix[matched];
+        node->prefix_length -= matched + 1;
+
+        if(node->owns_prefix)
+        {
+            dc_memmove(env, (char *)(uintptr_t)node->prefix, &node->prefix[matched + 1], node->prefix_length);
+        }
+        else
+        {
+            node->prefix = &node->prefix[matched + 1];
+        }
+
+        insert_child(env, split, byte, node);
+
+        if(leaf)
+        {
+            insert_child(env, split, (unsigned char)key[depth + matched], leaf);
+        }
+        else
+        {
+            split->key = key;
+        }
+
+        *node_ref = split;
+
+        return true;
+    }
+
+    depth += node->prefix_length;
+
+    if(key[depth] == '\0')
+    {
+        if(node->key != NULL)
+        {
+            return false;
+        }
+
+        node->key = key;
+
+        return true;
+    }
+
+    byte = (unsigned char)key[depth];
+    child_ref = find_child(env, node, byte);
+
+    if(child_ref)
+    {
+        return insert_key(env, err, child_ref, key, depth + 1);
+    }
+
+    leaf = create_leaf(env, err, key, depth + 1);
+
+    if(leaf == NULL)
+    {
+        return false;
+    }
+
+    if(!add_child(env, err, node_ref, byte, leaf))
+    {
+        destroy_node(env, leaf);
+
+        return false;
+    }
+
+    return true;
+}
+
+static const char *remove_key(const struct dc_env *env, struct dc_error *err, struct node **node_ref, const char *key, size_t depth)
+{
+    struct node *node;
+    struct node **child_ref;
+    const char *removed;
+    unsigned char byte;
+
+    DC_TRACE(env);
+    node = *node_ref;
+
+    if(match_prefix(env, node, key, depth) < node->prefix_length)
+    {
+        return NULL;
+    }
+
+    depth += node->prefix_length;
+
+    if(key[depth] == '\0')
+    {
+        removed = node->key;
+
+        // a node that may outlive the key, if only because collapsing it fails, can not keep pointing into it
+        if(removed && node->number_of_children > 0 && !own_prefix(env, err, node))
+        {
+            return NULL;
+        }
+
+        if(removed)
+        {
+            node->key = NULL;
+            collapse_node(env, err, node_ref);
+        }
+
+        return removed;
+    }
+
+    byte = (unsigned char)key[depth];
+    child_ref = find_child(env, node, byte);
+
+    if(child_ref == NULL)
+    {
+        return NULL;
+    }
+
+    removed = remove_key(env, err, child_ref, key, depth + 1);
+
+    if(removed && *child_ref == NULL)
+    {
+        remove_child(env, err, node_ref, byte);
+        collapse_node(env, err, node_ref);
+    }
+
+    return removed;
+}
+
+static void visit_subtree(const struct dc_env *env, struct dc_error *err, const struct node *node, dc_visitor visitor, void *state)
+{
+    struct node *child;
+    size_t cursor;
+
+    DC_TRACE(env);
+
+    // a string sorts before every string it is a prefix of
+    if(node->key)
+    {
+        visitor(env, err, node->key, state);
+    }
+
+    cursor = 0;
+
+    while((child = next_child(env, node, &cursor, NULL)) != NULL)
+    {
+        visit_subtree(env, err, child, visitor, state);
+    }
+}
+
+struct dc_radix_tree *dc_radix_tree_create(const struct dc_env *env, struct dc_error *err)
+{
+    struct dc_radix_tree *tree;
+
+    DC_TRACE(env);
+    tree = dc_calloc(env, err, 1, sizeof(struct dc_radix_tree));
+
+    if(dc_error_has_no_error(err))
+    {
+        check_tree(env, err, tree, 0);
+    }
+
+    return tree;
+}
+
+void dc_radix_tree_destroy(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree)
+{
+    DC_TRACE(env);
+    dc_radix_tree_clear(env, err, tree);
+    dc_free(env, tree);
+}
+
+bool dc_radix_tree_is_empty(const struct dc_env *env, const struct dc_radix_tree *tree)
+{
+    DC_TRACE(env);
+
+    return tree->number_of_elements == 0;
+}
+
+size_t dc_radix_tree_size(const struct dc_env *env, const struct dc_radix_tree *tree)
+{
+    DC_TRACE(env);
+
+    return tree->number_of_elements;
+}
+
+void dc_radix_tree_clear(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree)
+{
+    DC_TRACE(env);
+
+    if(tree->root)
+    {
+        destroy_subtree(env, tree->root);
+    }
+
+    tree->root = NULL;
+    tree->number_of_elements = 0;
+    check_tree(env, err, tree, 0);
+}
+
+bool dc_radix_tree_insert(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree, const char *key)
+{
+    size_t number_of_elements;
+    bool inserted;
+
+    DC_TRACE(env);
+    number_of_elements = tree->number_of_elements;
+    inserted = insert_key(env, err, &tree->root, key, 0);
+
+    if(inserted)
+    {
+        tree->number_of_elements++;
+    }
+
+    check_tree(env, err, tree, inserted ? number_of_elements + 1 : number_of_elements);
+
+    return inserted;
+}
+
+bool dc_radix_tree_contains(const struct dc_env *env, const struct dc_radix_tree *tree, const char *key)
+{
+    DC_TRACE(env);
+
+    return dc_radix_tree_get(env, tree, key) != NULL;
+}
+
+const char *dc_radix_tree_get(const struct dc_env *env, const struct dc_radix_tree *tree, const char *key)
+{
+    struct node *node;
+    size_t depth;
+
+    DC_TRACE(env);
+    node = tree->root;
+    depth = 0;
+
+    while(node)
+    {
+        struct node **child_ref;
+
+        if(match_prefix(env, node, key, depth) < node->prefix_length)
+        {
+            return NULL;
+        }
+
+        depth += node->prefix_length;
+
+        if(key[depth] == '\0')
+        {
+            return node->key;
+        }
+
+        child_ref = find_child(env, node, (unsigned char)key[depth]);
+        node = child_ref ? *child_ref : NULL;
+        depth++;
+    }
+
+    return NULL;
+}
+
+const char *dc_radix_tree_remove(const struct dc_env *env, struct dc_error *err, struct dc_radix_tree *tree, const char *key)
+{
+    size_t number_of_elements;
+    const char *removed;
+
+    DC_TRACE(env);
+    number_of_elements = tree->number_of_elements;
+
+    if(tree->root == NULL)
+    {
+        return NULL;
+    }
+
+    removed = remove_key(env, err, &tree->root, key, 0);
+
+    if(removed)
+    {
+        tree->number_of_elements--;
+    }
+
+    check_tree(env, err, tree, removed ? number_of_elements - 1 : number_of_elements);
+
+    return removed;
+}
+
+void dc_radix_tree_visit(const struct dc_env *env, struct dc_error *err, const struct dc_radix_tree *tree, dc_visitor visitor, void *state)
+{
+    DC_TRACE(env);
+
+    if(tree->root)
+    {
+        visit_subtree(env, err, tree->root, visitor, state);
+    }
+}
+
+void dc_radix_tree_visit_prefix(const struct dc_env *env, struct dc_error *err, const struct dc_radix_tree *tree, const char *prefix, dc_visitor visitor, void *state)
+{
+    struct node *node;
+    size_t depth;
+
+    DC_TRACE(env);
+    node = tree->root;
+    depth = 0;
+
+    while(node)
+    {
+        struct node **child_ref;
+        size_t matched;
+
+        matched = match_prefix(env, node, prefix, depth);
+
+        // running out of prefix inside the compressed path still matches everything below it
+        if(prefix[depth + matched] == '\0')
+        {
+            visit_subtree(env, err, node, visitor, state);
+            return;
+        }
+
+        if(matched < node->prefix_length)
+        {
+            return;
+        }
+
+        depth += node->prefix_length;
+        child_ref = find_child(env, node, (unsigned char)prefix[depth]);
+        node = child_ref ? *child_ref : NULL;
+        depth++;
+    }
+}
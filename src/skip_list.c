@@ -0,0 +1,831 @@
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/skip_list.h"
+#include <dc_c/dc_stdlib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+
+// with a 1 in 4 chance of going up a level this covers far more items than memory can hold
+#define MAX_LEVEL 24U
+#define MARK ((uintptr_t)1)
+
+
+struct link
+{
+    _Atomic(uintptr_t) next;    // low bit set once the node is logically removed at this level
+    size_t span;                // only kept up to date when the list is not concurrent
+};
+
+struct node
+{
+    const void *data;
+    struct node *retired_next;
+    unsigned int height;
+    struct link links[];
+};
+
+struct dc_skip_list
+{
+    dc_comparator comparator;
+    bool concurrent;
+    _Atomic(size_t) number_of_elements;
+    _Atomic(uint64_t) seed;
+    _Atomic(struct node *) retired;
+    struct node *head;
+};
+
+static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_skip_list *list);
+static struct node *create_node(const struct dc_env *env, struct dc_error *err, const void *item, unsigned int height);
+static unsigned int random_height(const struct dc_env *env, struct dc_skip_list *list);
+static uintptr_t load_next(const struct dc_env *env, const struct node *node, unsigned int level);
+static struct node *unmarked(const struct dc_env *env, uintptr_t next);
+static bool is_marked(const struct dc_env *env, uintptr_t next);
+static struct node *find_greater_or_equal(const struct dc_env *env, const struct dc_skip_list *list, const void *item);
+static struct node *next_live_node(const struct dc_env *env, const struct node *node);
+static bool sequential_add(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item);
+static void *sequential_remove(const struct dc_env *env, struct dc_skip_list *list, const void *item);
+static bool concurrent_find(const struct dc_env *env, const struct dc_skip_list *list, const void *item, struct node **preds, struct node **succs);
+static bool concurrent_add(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item);
+static void *concurrent_remove(const struct dc_env *env, struct dc_skip_list *list, const void *item);
+static void retire_node(const struct dc_env *env, struct dc_skip_list *list, struct node *node);
+
+static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_skip_list *list)
+{
+    DC_TRACE(env);
+
+    if(list->comparator == NULL)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    // other threads may be part way through an add or remove, so the count only has to agree when sequential
+    if(!list->concurrent && (load_next(env, list->head, 0) == (uintptr_t)NULL) != (atomic_load_explicit(&list->number_of_elements, memory_order_relaxed) == 0))
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 2);
+        return;
+    }
+}
+
+static struct node *create_node(const struct dc_env *env, struct dc_error *err, const void *item, unsigned int height)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    node = dc_calloc(env, err, 1, sizeof(struct node) + (height * sizeof(struct link)));
+
+    if(dc_error_has_no_error(err))
+    {
+        node->data = item;
+        node->height = height;
+    }
+
+    return node;
+}
+
+static unsigned int random_height(const struct dc_env *env, struct dc_skip_list *list)
+{
+    uint64_t bits;
+    unsigned int height;
+
+    DC_TRACE(env);
+
+    // splitmix64 over a shared counter, so writers on different threads never share generator state
+    bits = atomic_fetch_add_explicit(&list->seed, UINT64_C(0x9E3779B97F4A7C15), memory_order_relaxed);
+    bits = (bits ^ (bits >> 30U)) * UINT64_C(0xBF58476D1CE4E5B9);
+    bits = (bits ^ (bits >> 27U)) * UINT64_C(0x94D049BB133111EB);
+    bits ^= bits >> 31U;
+    height = 1;
+
+    while(height < MAX_LEVEL && (bits & 3U) == 0)
+    {
+        height++;
+        bits >>= 2U;
+    }
+
+    return height;
+}
+
+static uintptr_t load_next(const struct dc_env *env, const struct node *node, unsigned int level)
+{
+    DC_TRACE(env);
+
+    return atomic_load_explicit(&node->links[level].next, memory_order_acquire);
+}
+
+static struct node *unmarked(const struct dc_env *env, uintptr_t next)
+{
+    DC_TRACE(env);
+
+    return (struct node *)(next & ~MARK);
+}
+
+static bool is_marked(const struct dc_env *env, uintptr_t next)
+{
+    DC_TRACE(env);
+
+    return (next & MARK) != 0;
+}
+
+// wait-free in concurrent mode: removed nodes are stepped over, never unlinked
+static struct node *find_greater_or_equal(const struct dc_env *env, const struct dc_skip_list *list, const void *item)
+{
+    struct node *pred;
+    struct node *curr;
+
+    DC_TRACE(env);
+    pred = list->head;
+    curr = NULL;
+
+    for(unsigned int level = MAX_LEVEL; level-- > 0;)
+    {
+        curr = unmarked(env, load_next(env, pred, level));
+
+        while(curr)
+        {
+            uintptr_t next;
+
+            next = load_next(env, curr, level);
+
+            if(is_marked(env, next))
+            {
+                curr = unmarked(env, next);
+            }
+            else if(list->comparator(env, curr->data, item) < 0)
+            {
+                pred = curr;
+                curr = unmarked(env, next);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    return curr;
+}
+
+static struct node *next_live_node(const struct dc_env *env, const struct node *node)
+{
+    struct node *next;
+
+    DC_TRACE(env);
+    next = unmarked(env, load_next(env, node, 0));
+
+    while(next && is_marked(env, load_next(env, next, 0)))
+    {
+        next = unmarked(env, load_next(env, next, 0));
+    }
+
+    return next;
+}
+
+static bool sequential_add(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item)
+{
+    struct node *update[MAX_LEVEL];
+    size_t rank[MAX_LEVEL];
+    struct node *node;
+    struct node *next;
+    unsigned int height;
+
+    DC_TRACE(env);
+    node = list->head;
+
+    for(unsigned int level = MAX_LEVEL; level-- > 0;)
+    {
+        rank[level] = (level == MAX_LEVEL - 1) ? 0 : rank[level + 1];
+
+        while((next = unmarked(env, load_next(env, node, level))) != NULL && list->comparator(env, next->data, item) < 0)
+        {
+            rank[level] += node->links[level].span;
+            node = next;
+        }
+
+        update[level] = node;
+    }
+
+    next = unmarked(env, load_next(env, node, 0));
+
+    if(next && list->comparator(env, next->data, item) == 0)
+    {
+        return false;
+    }
+
+    height = random_height(env, list);
+    node = create_node(env, err, item, height);
+
+    if(dc_error_has_error(err))
+    {
+        return false;
+    }
+
+    for(unsigned int level = 0; level < height; level++)
+    {
+        atomic_store_explicit(&node->links[level].next, load_next(env, update[level], level), memory_order_relaxed);
+        atomic_store_explicit(&update[level]->links[level].next, (uintptr_t)node, memory_order_release);
+        node->links[level].span = update[level]->links[level].span - (rank[0] - rank[level]);
+        update[level]->links[level].span = (rank[0] - rank[level]) + 1;
+    }
+
+    for(unsigned int level = height; level < MAX_LEVEL; level++)
+    {
+        update[level]->links[level].span++;
+    }
+
+    atomic_fetch_add_explicit(&list->number_of_elements, 1, memory_order_relaxed);
+
+    return true;
+}
+
+static void *sequential_remove(const struct dc_env *env, struct dc_skip_list *list, const void *item)
+{
+    struct node *update[MAX_LEVEL];
+    struct node *node;
+    struct node *next;
+    void *data;
+
+    DC_TRACE(env);
+    node = list->head;
+
+    for(unsigned int level = MAX_LEVEL; level-- > 0;)
+    {
+        while((next = unmarked(env, load_next(env, node, level))) != NULL && list->comparator(env, next->data, item) < 0)
+        {
+            node = next;
+        }
+
+        update[level] = node;
+    }
+
+    node = unmarked(env, load_next(env, node, 0));
+
+    if(node == NULL || list->comparator(env, node->data, item) != 0)
+    {
+        return NULL;
+    }
+
+    for(unsigned int level = 0; level < MAX_LEVEL; level++)
+    {
+        if(unmarked(env, load_next(env, update[level], level)) == node)
+        {
+            update[level]->links[level].span += node->links[level].span - 1;
+            atomic_store_explicit(&update[level]->links[level].next, load_next(env, node, level), memory_order_relaxed);
+        }
+        else
+        {
+            update[level]->links[level].span--;
+        }
+    }
+
+    data = (void *)(uintptr_t)node->data;
+    dc_free(env, node);
+    atomic_fetch_sub_explicit(&list->number_of_elements, 1, memory_order_relaxed);
+
+    return data;
+}
+
+// fills in the neighbours of item at every level, unlinking removed nodes on the way (Herlihy & Shavit)
+static bool concurrent_find(const struct dc_env *env, const struct dc_skip_list *list, const void *item, struct node **preds, struct node **succs)
+{
+    bool restart;
+
+    DC_TRACE(env);
+
+    do
+    {
+        struct node *pred;
+
+        restart = false;
+        pred = list->head;
+
+        for(unsigned int level = MAX_LEVEL; level-- > 0 && !restart;)
+        {
+            struct node *curr;
+
+            curr = unmarked(env, load_next(env, pred, level));
+
+            while(curr)
+            {
+                uintptr_t next;
+
+                next = load_next(env, curr, level);
+
+                if(is_marked(env, next))
+                {
+                    uintptr_t expected;
+
+                    expected = (uintptr_t)curr;
+
+                    // pred changed or is being removed itself, start again from the top
+                    if(!atomic_compare_exchange_strong_explicit(&pred->links[level].next, &expected, next & ~MARK, memory_order_acq_rel, memory_order_acquire))
+                    {
+                        restart = true;
+                        break;
+                    }
+
+                    curr = unmarked(env, next);
+                }
+                else if(list->comparator(env, curr->data, item) < 0)
+                {
+                    pred = curr;
+                    curr = unmarked(env, next);
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+    }
+    while(restart);
+
+    return succs[0] != NULL && list->comparator(env, succs[0]->data, item) == 0;
+}
+
+static bool concurrent_add(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item)
+{
+    struct node *preds[MAX_LEVEL];
+    struct node *succs[MAX_LEVEL];
+    struct node *node;
+    unsigned int height;
+
+    DC_TRACE(env);
+    height = random_height(env, list);
+    node = NULL;
+
+    // the bottom level decides membership, the levels above are only shortcuts
+    for(;;)
+    {
+        uintptr_t expected;
+
+        if(concurrent_find(env, list, item, preds, succs))
+        {
+            if(node)
+            {
+                dc_free(env, node);
+            }
+
+            return false;
+        }
+
+        if(node == NULL)
+        {
+            node = create_node(env, err, item, height);
+
+            if(dc_error_has_error(err))
+            {
+                return false;
+            }
+        }
+
+        for(unsigned int level = 0; level < height; level++)
+        {
+            atomic_store_explicit(&node->links[level].next, (uintptr_t)succs[level], memory_order_relaxed);
+        }
+
+        expected = (uintptr_t)succs[0];
+
+        if(atomic_compare_exchange_strong_explicit(&preds[0]->links[0].next, &expected, (uintptr_t)node, memory_order_acq_rel, memory_order_acquire))
+        {
+            break;
+        }
+    }
+
+    atomic_fetch_add_explicit(&list->number_of_elements, 1, memory_order_relaxed);
+
+    for(unsigned int level = 1; level < height; level++)
+    {
+        for(;;)
+        {
+            uintptr_t next;
+            uintptr_t expected;
+
+            next = load_next(env, node, level);
+
+            // a remover got to the node first, leave the rest of the levels unlinked
+            if(is_marked(env, next))
+            {
+                return true;
+            }
+
+            if(unmarked(env, next) != succs[level] && !atomic_compare_exchange_strong_explicit(&node->links[level].next, &next, (uintptr_t)succs[level], memory_order_acq_rel, memory_order_acquire))
+            {
+                continue;
+            }
+
+            expected = (uintptr_t)succs[level];
+
+            if(atomic_compare_exchange_strong_explicit(&preds[level]->links[level].next, &expected, (uintptr_t)node, memory_order_acq_rel, memory_order_acquire))
+            {
+                break;
+            }
+
+            if(!concurrent_find(env, list, item, preds, succs) || succs[0] != node)
+            {
+                return true;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void *concurrent_remove(const struct dc_env *env, struct dc_skip_list *list, const void *item)
+{
+    struct node *preds[MAX_LEVEL];
+    struct node *succs[MAX_LEVEL];
+    struct node *victim;
+    uintptr_t next;
+
+    DC_TRACE(env);
+
+    if(!concurrent_find(env, list, item, preds, succs))
+    {
+        return NULL;
+    }
+
+    victim = succs[0];
+
+    for(unsigned int level = victim->height; level-- > 1;)
+    {
+        next = load_next(env, victim, level);
+
+        while(!is_marked(env, next))
+        {
+            atomic_compare_exchange_weak_explicit(&victim->links[level].next, &next, next | MARK, memory_order_acq_rel, memory_order_acquire);
+        }
+    }
+
+    next = load_next(env, victim, 0);
+
+    // whoever marks the bottom level owns the removal
+    while(!is_marked(env, next))
+    {
+        if(atomic_compare_exchange_weak_explicit(&victim->links[0].next, &next, next | MARK, memory_order_acq_rel, memory_order_acquire))
+        {
+            atomic_fetch_sub_explicit(&list->number_of_elements, 1, memory_order_relaxed);
+            concurrent_find(env, list, item, preds, succs);
+            retire_node(env, list, victim);
+
+            return (void *)(uintptr_t)victim->data;
+        }
+    }
+
+    return NULL;
+}
+
+static void retire_node(const struct dc_env *env, struct dc_skip_list *list, struct node *node)
+{
+    struct node *head;
+
+    DC_TRACE(env);
+    head = atomic_load_explicit(&list->retired, memory_order_relaxed);
+
+    do
+    {
+        node->retired_next = head;
+    }
+    while(!atomic_compare_exchange_weak_explicit(&list->retired, &head, node, memory_order_release, memory_order_relaxed));
+}
+
+struct dc_skip_list *dc_skip_list_create(const struct dc_env *env, struct dc_error *err, dc_comparator comparator, bool concurrent)
+{
+    struct dc_skip_list *list;
+
+    DC_TRACE(env);
+    list = dc_calloc(env, err, 1, sizeof(struct dc_skip_list));
+
+    if(dc_error_has_error(err))
+    {
+        return NULL;
+    }
+
+    list->head = create_node(env, err, NULL, MAX_LEVEL);
+
+    if(dc_error_has_error(err))
+    {
+        dc_free(env, list);
+
+        return NULL;
+    }
+
+    list->comparator = comparator;
+    list->concurrent = concurrent;
+    atomic_init(&list->number_of_elements, 0);
+    atomic_init(&list->seed, (uint64_t)(uintptr_t)list);
+    atomic_init(&list->retired, NULL);
+
+    return list;
+}
+
+void dc_skip_list_destroy(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list)
+{
+    DC_TRACE(env);
+    dc_skip_list_clear(env, err, list);
+    dc_free(env, list->head);
+    dc_free(env, list);
+}
+
+bool dc_skip_list_is_empty(const struct dc_env *env, const struct dc_skip_list *list)
+{
+    DC_TRACE(env);
+
+    return dc_skip_list_size(env, list) == 0;
+}
+
+size_t dc_skip_list_size(const struct dc_env *env, const struct dc_skip_list *list)
+{
+    DC_TRACE(env);
+
+    return atomic_load_explicit(&list->number_of_elements, memory_order_relaxed);
+}
+
+void dc_skip_list_clear(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    dc_skip_list_reclaim(env, list);
+    node = unmarked(env, load_next(env, list->head, 0));
+
+    while(node)
+    {
+        struct node *next;
+
+        next = unmarked(env, load_next(env, node, 0));
+        dc_free(env, node);
+        node = next;
+    }
+
+    for(unsigned int level = 0; level < MAX_LEVEL; level++)
+    {
+        atomic_store_explicit(&list->head->links[level].next, (uintptr_t)NULL, memory_order_relaxed);
+        list->head->links[level].span = 0;
+    }
+
+    atomic_store_explicit(&list->number_of_elements, 0, memory_order_relaxed);
+    check_list(env, err, list);
+}
+
+bool dc_skip_list_add(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item)
+{
+    bool ret_val;
+
+    DC_TRACE(env);
+
+    if(list->concurrent)
+    {
+        ret_val = concurrent_add(env, err, list, item);
+    }
+    else
+    {
+        ret_val = sequential_add(env, err, list, item);
+    }
+
+    check_list(env, err, list);
+
+    return ret_val;
+}
+
+bool dc_skip_list_contains(const struct dc_env *env, const struct dc_skip_list *list, const void *item)
+{
+    DC_TRACE(env);
+
+    return dc_skip_list_get(env, list, item) != NULL;
+}
+
+void *dc_skip_list_get(const struct dc_env *env, const struct dc_skip_list *list, const void *item)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+    node = find_greater_or_equal(env, list, item);
+
+    if(node == NULL || list->comparator(env, node->data, item) != 0)
+    {
+        return NULL;
+    }
+
+    return (void *)(uintptr_t)node->data;
+}
+
+void *dc_skip_list_remove(const struct dc_env *env, struct dc_error *err, struct dc_skip_list *list, const void *item)
+{
+    void *data;
+
+    DC_TRACE(env);
+
+    if(list->concurrent)
+    {
+        data = concurrent_remove(env, list, item);
+    }
+    else
+    {
+        data = sequential_remove(env, list, item);
+    }
+
+    check_list(env, err, list);
+
+    return data;
+}
+
+struct dc_skip_list_item dc_skip_list_get_at(const struct dc_env *env, const struct dc_skip_list *list, size_t index)
+{
+    struct dc_skip_list_item item;
+    struct node *node;
+
+    DC_TRACE(env);
+    item.index = -1;
+    item.data = NULL;
+
+    if(list->concurrent)
+    {
+        size_t current_index;
+
+        current_index = 0;
+
+        for(node = next_live_node(env, list->head); node; node = next_live_node(env, node))
+        {
+            if(current_index == index)
+            {
+                item.index = (ssize_t)index;
+                item.data = (void *)(uintptr_t)node->data;
+                break;
+            }
+
+            current_index++;
+        }
+    }
+    else
+    {
+        size_t traversed;
+
+        // spans count bottom level steps, so add them up until the rank (index + 1) is reached
+        traversed = 0;
+        node = list->head;
+
+        for(unsigned int level = MAX_LEVEL; level-- > 0;)
+        {
+            struct node *next;
+
+            while((next = unmarked(env, load_next(env, node, level))) != NULL && traversed + node->links[level].span <= index + 1)
+            {
+                traversed += node->links[level].span;
+                node = next;
+            }
+
+            if(traversed == index + 1)
+            {
+                item.index = (ssize_t)index;
+                item.data = (void *)(uintptr_t)node->data;
+                break;
+            }
+        }
+    }
+
+    return item;
+}
+
+ssize_t dc_skip_list_index_of(const struct dc_env *env, const struct dc_skip_list *list, const void *item)
+{
+    struct node *node;
+    struct node *next;
+    size_t rank;
+
+    DC_TRACE(env);
+    rank = 0;
+
+    if(list->concurrent)
+    {
+        for(node = next_live_node(env, list->head); node; node = next_live_node(env, node))
+        {
+            int comparison;
+
+            comparison = list->comparator(env, node->data, item);
+
+            if(comparison == 0)
+            {
+                return (ssize_t)rank;
+            }
+
+            if(comparison > 0)
+            {
+                break;
+            }
+
+            rank++;
+        }
+
+        return -1;
+    }
+
+    node = list->head;
+
+    for(unsigned int level = MAX_LEVEL; level-- > 0;)
+    {
+        while((next = unmarked(env, load_next(env, node, level))) != NULL && list->comparator(env, next->data, item) < 0)
+        {
+            rank += node->links[level].span;
+            node = next;
+        }
+    }
+
+    next = unmarked(env, load_next(env, node, 0));
+
+    if(next == NULL || list->comparator(env, next->data, item) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)rank;
+}
+
+void dc_skip_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_skip_list *list, dc_visitor visitor, void *state)
+{
+    DC_TRACE(env);
+    dc_skip_list_visit_range(env, err, list, NULL, NULL, visitor, state);
+}
+
+void dc_skip_list_visit_range(const struct dc_env *env, struct dc_error *err, const struct dc_skip_list *list, const void *from, const void *to, dc_visitor visitor, void *state)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+
+    if(from)
+    {
+        node = find_greater_or_equal(env, list, from);
+    }
+    else
+    {
+        node = next_live_node(env, list->head);
+    }
+
+    while(node && (to == NULL || list->comparator(env, node->data, to) < 0))
+    {
+        visitor(env, err, node->data, state);
+        node = next_live_node(env, node);
+    }
+}
+
+void dc_skip_list_reclaim(const struct dc_env *env, struct dc_skip_list *list)
+{
+    struct node *node;
+
+    DC_TRACE(env);
+
+    // a writer can link a node at an upper level just after it was removed, so unlink every marked node first
+    for(unsigned int level = 0; level < MAX_LEVEL; level++)
+    {
+        struct node *pred;
+
+        pred = list->head;
+
+        while((node = unmarked(env, load_next(env, pred, level))) != NULL)
+        {
+            uintptr_t next;
+
+            next = load_next(env, node, level);
+
+            if(is_marked(env, next) || is_marked(env, load_next(env, node, 0)))
+            {
+                atomic_store_explicit(&pred->links[level].next, next & ~MARK, memory_order_relaxed);
+            }
+            else
+            {
+                pred = node;
+            }
+        }
+    }
+
+    node = atomic_exchange_explicit(&list->retired, NULL, memory_order_acquire);
+
+    while(node)
+    {
+        struct node *next;
+
+        next = node->retired_next;
+        dc_free(env, node);
+        node = next;
+    }
+}
@@ -0,0 +1,593 @@
+/*
+ * Copyright 2022-2022 D'Arcy Smith.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dc_collections/small_list.h"
+#include <dc_c/dc_stdlib.h>
+#include <stdint.h>
+
+
+struct dc_small_list_node
+{
+    const void *data;
+    struct dc_small_list_node *next;
+    struct dc_small_list_node *prev;
+};
+
+static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_small_list *list, size_t number_of_elements);
+static size_t inline_count(const struct dc_env *env, const struct dc_small_list *list);
+static struct dc_small_list_node *get_overflow_node_at(const struct dc_env *env, const struct dc_small_list *list, size_t index);
+static void link_overflow_node(const struct dc_env *env, struct dc_small_list *list, struct dc_small_list_node *node, size_t index);
+static void unlink_overflow_node(const struct dc_env *env, struct dc_small_list *list, struct dc_small_list_node *node);
+
+static void check_list(const struct dc_env *env, struct dc_error *err, const struct dc_small_list *list, size_t number_of_elements)
+{
+    DC_TRACE(env);
+
+    if(list->comparator == NULL)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        return;
+    }
+
+    if(list->number_of_elements != number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 2);
+        return;
+    }
+
+    if(list->number_of_elements <= DC_SMALL_LIST_INLINE_CAPACITY)
+    {
+        if(list->overflow_head != NULL)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", 3);
+            return;
+        }
+
+        if(list->overflow_tail != NULL)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", 4);
+            return;
+        }
+    }
+    else
+    {
+        if(list->overflow_head == NULL || list->overflow_head->prev != NULL)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", 5);
+            return;
+        }
+
+        if(list->overflow_tail == NULL || list->overflow_tail->next != NULL)
+        {
+            DC_ERROR_RAISE_SYSTEM(err, "", 6);
+            return;
+        }
+    }
+}
+
+static size_t inline_count(const struct dc_env *env, const struct dc_small_list *list)
+{
+    DC_TRACE(env);
+
+    if(list->number_of_elements < DC_SMALL_LIST_INLINE_CAPACITY)
+    {
+        return list->number_of_elements;
+    }
+
+    return DC_SMALL_LIST_INLINE_CAPACITY;
+}
+
+static struct dc_small_list_node *get_overflow_node_at(const struct dc_env *env, const struct dc_small_list *list, size_t index)
+{
+    struct dc_small_list_node *tmp;
+    size_t overflow_count;
+
+    DC_TRACE(env);
+    overflow_count = list->number_of_elements - DC_SMALL_LIST_INLINE_CAPACITY;
+
+    if(index < overflow_count / 2)
+    {
+        tmp = list->overflow_head;
+
+        for(size_t current_index = 0; current_index < index; current_index++)
+        {
+            tmp = tmp->next;
+        }
+    }
+    else
+    {
+        tmp = list->overflow_tail;
+
+        for(size_t current_index = overflow_count - 1; current_index > index; current_index--)
+        {
+            tmp = tmp->prev;
+        }
+    }
+
+    return tmp;
+}
+
+static void link_overflow_node(const struct dc_env *env, struct dc_small_list *list, struct dc_small_list_node *node, size_t index)
+{
+    struct dc_small_list_node *next;
+
+    DC_TRACE(env);
+
+    // index is the position in the overflow chain before the list grows
+    if(list->number_of_elements - DC_SMALL_LIST_INLINE_CAPACITY == index)
+    {
+        next = NULL;
+    }
+    else
+    {
+        next = get_overflow_node_at(env, list, index);
+    }
+
+    node->next = next;
+
+    if(next)
+    {
+        node->prev = next->prev;
+        next->prev = node;
+    }
+    else
+    {
+        node->prev = list->overflow_tail;
+        list->overflow_tail = node;
+    }
+
+    if(node->prev)
+    {
+        node->prev->next = node;
+    }
+    else
+    {
+        list->overflow_head = node;
+    }
+}
+
+static void unlink_overflow_node(const struct dc_env *env, struct dc_small_list *list, struct dc_small_list_node *node)
+{
+    DC_TRACE(env);
+
+    if(node->prev)
+    {
+        node->prev->next = node->next;
+    }
+    else
+    {
+        list->overflow_head = node->next;
+    }
+
+    if(node->next)
+    {
+        node->next->prev = node->prev;
+    }
+    else
+    {
+        list->overflow_tail = node->prev;
+    }
+}
+
+void dc_small_list_init(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, dc_comparator comparator)
+{
+    DC_TRACE(env);
+    list->number_of_elements = 0;
+    list->comparator = comparator;
+
+    for(size_t i = 0; i < DC_SMALL_LIST_INLINE_CAPACITY; i++)
+    {
+        list->inline_data[i] = NULL;
+    }
+
+    list->overflow_head = NULL;
+    list->overflow_tail = NULL;
+    check_list(env, err, list, 0);
+}
+
+struct dc_small_list *dc_small_list_create(const struct dc_env *env, struct dc_error *err, dc_comparator comparator)
+{
+    struct dc_small_list *list;
+
+    DC_TRACE(env);
+    list = dc_calloc(env, err, 1, sizeof(struct dc_small_list));
+
+    if(dc_error_has_no_error(err))
+    {
+        dc_small_list_init(env, err, list, comparator);
+    }
+
+    return list;
+}
+
+void dc_small_list_destroy(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list)
+{
+    DC_TRACE(env);
+    dc_small_list_clear(env, err, list);
+    dc_free(env, list);
+}
+
+bool dc_small_list_is_empty(const struct dc_env *env, const struct dc_small_list *list)
+{
+    DC_TRACE(env);
+
+    return list->number_of_elements == 0;
+}
+
+size_t dc_small_list_size(const struct dc_env *env, const struct dc_small_list *list)
+{
+    DC_TRACE(env);
+
+    return list->number_of_elements;
+}
+
+void dc_small_list_clear(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list)
+{
+    DC_TRACE(env);
+
+    for(struct dc_small_list_node *tmp = list->overflow_head; tmp;)
+    {
+        struct dc_small_list_node *next;
+
+        next = tmp->next;
+        dc_free(env, tmp);
+        tmp = next;
+    }
+
+    for(size_t i = 0; i < DC_SMALL_LIST_INLINE_CAPACITY; i++)
+    {
+        list->inline_data[i] = NULL;
+    }
+
+    list->number_of_elements = 0;
+    list->overflow_head = NULL;
+    list->overflow_tail = NULL;
+    check_list(env, err, list, 0);
+}
+
+bool dc_small_list_add_first(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, const void *item)
+{
+    bool ret_val;
+
+    DC_TRACE(env);
+    ret_val = dc_small_list_add_at(env, err, list, 0, item);
+
+    return ret_val;
+}
+
+ssize_t dc_small_list_add_last(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, const void *item)
+{
+    ssize_t ret_val;
+
+    DC_TRACE(env);
+    dc_small_list_add_at(env, err, list, list->number_of_elements, item);
+
+    if(dc_error_has_error(err))
+    {
+        ret_val = -1;
+    }
+    else
+    {
+        ret_val = (ssize_t)list->number_of_elements;
+    }
+
+    return ret_val;
+}
+
+bool dc_small_list_add_at(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, size_t index, const void *item)
+{
+    size_t number_of_elements;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+
+    if(index > number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+
+        return false;
+    }
+
+    if(number_of_elements < DC_SMALL_LIST_INLINE_CAPACITY)
+    {
+        for(size_t i = number_of_elements; i > index; i--)
+        {
+            list->inline_data[i] = list->inline_data[i - 1];
+        }
+
+        list->inline_data[index] = item;
+    }
+    else
+    {
+        struct dc_small_list_node *new_node;
+
+        new_node = dc_calloc(env, err, 1, sizeof(struct dc_small_list_node));
+
+        if(dc_error_has_error(err))
+        {
+            return false;
+        }
+
+        if(index >= DC_SMALL_LIST_INLINE_CAPACITY)
+        {
+            new_node->data = item;
+            link_overflow_node(env, list, new_node, index - DC_SMALL_LIST_INLINE_CAPACITY);
+        }
+        else
+        {
+            // the last inline item spills to the front of the overflow chain
+            new_node->data = list->inline_data[DC_SMALL_LIST_INLINE_CAPACITY - 1];
+            link_overflow_node(env, list, new_node, 0);
+
+            for(size_t i = DC_SMALL_LIST_INLINE_CAPACITY - 1; i > index; i--)
+            {
+                list->inline_data[i] = list->inline_data[i - 1];
+            }
+
+            list->inline_data[index] = item;
+        }
+    }
+
+    list->number_of_elements++;
+    check_list(env, err, list, number_of_elements + 1);
+
+    return dc_error_has_no_error(err);
+}
+
+void *dc_small_list_set(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, size_t index, const void *item)
+{
+    void *old_data;
+
+    DC_TRACE(env);
+    old_data = NULL;
+
+    if(index >= list->number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+    }
+    else if(index < DC_SMALL_LIST_INLINE_CAPACITY)
+    {
+        old_data = (void *)(uintptr_t)list->inline_data[index];
+        list->inline_data[index] = item;
+    }
+    else
+    {
+        struct dc_small_list_node *node;
+
+        node = get_overflow_node_at(env, list, index - DC_SMALL_LIST_INLINE_CAPACITY);
+        old_data = (void *)(uintptr_t)node->data;
+        node->data = item;
+    }
+
+    return old_data;
+}
+
+struct dc_small_list_item dc_small_list_get_first(const struct dc_env *env, const struct dc_small_list *list)
+{
+    struct dc_small_list_item item;
+
+    DC_TRACE(env);
+    item = dc_small_list_get_at(env, list, 0);
+
+    return item;
+}
+
+struct dc_small_list_item dc_small_list_get_last(const struct dc_env *env, const struct dc_small_list *list)
+{
+    struct dc_small_list_item item;
+
+    DC_TRACE(env);
+
+    if(list->number_of_elements == 0)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item = dc_small_list_get_at(env, list, list->number_of_elements - 1);
+    }
+
+    return item;
+}
+
+struct dc_small_list_item dc_small_list_get_at(const struct dc_env *env, const struct dc_small_list *list, size_t index)
+{
+    struct dc_small_list_item item;
+
+    DC_TRACE(env);
+
+    if(index >= list->number_of_elements)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else if(index < DC_SMALL_LIST_INLINE_CAPACITY)
+    {
+        item.index = (ssize_t)index;
+        item.data = (void *)(uintptr_t)list->inline_data[index];
+    }
+    else if(index == list->number_of_elements - 1)
+    {
+        item.index = (ssize_t)index;
+        item.data = (void *)(uintptr_t)list->overflow_tail->data;
+    }
+    else
+    {
+        struct dc_small_list_node *node;
+
+        node = get_overflow_node_at(env, list, index - DC_SMALL_LIST_INLINE_CAPACITY);
+        item.index = (ssize_t)index;
+        item.data = (void *)(uintptr_t)node->data;
+    }
+
+    return item;
+}
+
+bool dc_small_list_contains(const struct dc_env *env, const struct dc_small_list *list, const void *item)
+{
+    DC_TRACE(env);
+
+    return dc_small_list_index_of(env, list, item) != -1;
+}
+
+ssize_t dc_small_list_index_of(const struct dc_env *env, const struct dc_small_list *list, const void *item)
+{
+    size_t count;
+    size_t index;
+
+    DC_TRACE(env);
+    count = inline_count(env, list);
+
+    for(index = 0; index < count; index++)
+    {
+        if(list->comparator(env, item, list->inline_data[index]) == 0)
+        {
+            return (ssize_t)index;
+        }
+    }
+
+    for(struct dc_small_list_node *tmp = list->overflow_head; tmp; tmp = tmp->next)
+    {
+        if(list->comparator(env, item, tmp->data) == 0)
+        {
+            return (ssize_t)index;
+        }
+
+        index++;
+    }
+
+    return -1;
+}
+
+struct dc_small_list_item dc_small_list_remove_first(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list)
+{
+    struct dc_small_list_item item;
+
+    DC_TRACE(env);
+
+    if(list->number_of_elements == 0)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item = dc_small_list_remove_at(env, err, list, 0);
+    }
+
+    return item;
+}
+
+struct dc_small_list_item dc_small_list_remove_last(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list)
+{
+    struct dc_small_list_item item;
+
+    DC_TRACE(env);
+
+    if(list->number_of_elements == 0)
+    {
+        item.index = -1;
+        item.data = NULL;
+    }
+    else
+    {
+        item = dc_small_list_remove_at(env, err, list, list->number_of_elements - 1);
+    }
+
+    return item;
+}
+
+struct dc_small_list_item dc_small_list_remove_at(const struct dc_env *env, struct dc_error *err, struct dc_small_list *list, size_t index)
+{
+    size_t number_of_elements;
+    struct dc_small_list_item item;
+
+    DC_TRACE(env);
+    number_of_elements = list->number_of_elements;
+
+    if(index >= number_of_elements)
+    {
+        DC_ERROR_RAISE_SYSTEM(err, "", 1);
+        item.index = -1;
+        item.data = NULL;
+
+        return item;
+    }
+
+    item.index = (ssize_t)index;
+
+    if(index >= DC_SMALL_LIST_INLINE_CAPACITY)
+    {
+        struct dc_small_list_node *node;
+
+        node = get_overflow_node_at(env, list, index - DC_SMALL_LIST_INLINE_CAPACITY);
+        item.data = (void *)(uintptr_t)node->data;
+        unlink_overflow_node(env, list, node);
+        dc_free(env, node);
+    }
+    else
+    {
+        size_t count;
+
+        count = inline_count(env, list);
+        item.data = (void *)(uintptr_t)list->inline_data[index];
+
+        for(size_t i = index; i + 1 < count; i++)
+        {
+            list->inline_data[i] = list->inline_data[i + 1];
+        }
+
+        // the front of the overflow chain moves back into the inline storage
+        if(list->overflow_head)
+        {
+            struct dc_small_list_node *node;
+
+            node = list->overflow_head;
+            list->inline_data[DC_SMALL_LIST_INLINE_CAPACITY - 1] = node->data;
+            unlink_overflow_node(env, list, node);
+            dc_free(env, node);
+        }
+        else
+        {
+            list->inline_data[count - 1] = NULL;
+        }
+    }
+
+    list->number_of_elements--;
+    check_list(env, err, list, number_of_elements - 1);
+
+    return item;
+}
+
+void dc_small_list_visit(const struct dc_env *env, struct dc_error *err, const struct dc_small_list *list, dc_visitor visitor, void *state)
+{
+    size_t count;
+
+    DC_TRACE(env);
+    count = inline_count(env, list);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        visitor(env, err, list->inline_data[i], state);
+    }
+
+    for(struct dc_small_list_node *tmp = list->overflow_head; tmp; tmp = tmp->next)
+    {
+        visitor(env, err, tmp->data, state);
+    }
+}
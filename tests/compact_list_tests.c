@@ -0,0 +1,388 @@
+#include "tests.h"
+#include "dc_collections/compact_list.h"
+#include <dc_env/env.h>
+#include <dc_error/error.h>
+#include <stdint.h>
+
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+
+static struct dc_env *env;
+static struct dc_error *err;
+
+// a snapshot is a fixed header followed by one node, a data pointer and two links, for each used slot
+#define SNAPSHOT_HEADER_SIZE (sizeof(uint64_t) + (4 * sizeof(uint32_t)))
+#define SNAPSHOT_NODE_SIZE (sizeof(void *) + (2 * sizeof(uint32_t)))
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+Describe(compact_list);
+#pragma GCC diagnostic pop
+
+BeforeEach(compact_list)
+{
+    err = dc_error_create(false);
+    env = dc_env_create(err, false, NULL);
+}
+
+AfterEach(compact_list)
+{
+    free(env);
+    dc_error_reset(err);
+    free(err);
+}
+
+static size_t used_slots(const struct dc_compact_list *list)
+{
+    return (dc_compact_list_snapshot_size(env, list) - SNAPSHOT_HEADER_SIZE) / SNAPSHOT_NODE_SIZE;
+}
+
+Ensure(compact_list, add_remove)
+{
+    struct dc_compact_list *list;
+    struct dc_compact_list_item item;
+    void *array[4];
+    size_t size;
+
+    list = dc_compact_list_create(env, err, dc_string_comparator);
+    assert_true(dc_compact_list_is_empty(env, list));
+
+    dc_compact_list_add_last(env, err, list, "B");
+    dc_compact_list_add_first(env, err, list, "A");
+    dc_compact_list_add_last(env, err, list, "D");
+    dc_compact_list_add_at(env, err, list, 2, "C");
+    dc_compact_list_add_last(env, err, list, "B");
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_compact_list_size(env, list), is_equal_to(5));
+    assert_that(dc_compact_list_get_at(env, list, 2).data, is_equal_to_string("C"));
+    assert_that(dc_compact_list_index_of(env, list, "B"), is_equal_to(1));
+    assert_that(dc_compact_list_last_index_of(env, list, "B"), is_equal_to(4));
+    assert_false(dc_compact_list_contains(env, list, "E"));
+
+    item = dc_compact_list_remove_last_occurrence(env, err, list, "B");
+    assert_that(item.index, is_equal_to(4));
+    item = dc_compact_list_remove_at(env, err, list, 0);
+    assert_that(item.data, is_equal_to_string("A"));
+
+    // the two freed slots are reused before the array grows
+    size = dc_compact_list_snapshot_size(env, list);
+    dc_compact_list_add_first(env, err, list, "A");
+    dc_compact_list_add_last(env, err, list, "A");
+    assert_that(dc_compact_list_snapshot_size(env, list), is_equal_to(size));
+    assert_that(dc_compact_list_remove_all_occurrences(env, err, list, "A"), is_equal_to(2));
+
+    dc_compact_list_to_array(env, list, array, 4);
+    assert_that(array[0], is_equal_to_string("B"));
+    assert_that(array[1], is_equal_to_string("C"));
+    assert_that(array[2], is_equal_to_string("D"));
+    assert_false(dc_error_has_error(err));
+    dc_compact_list_destroy(env, err, list);
+}
+
+static bool is_even(const struct dc_env *environment, const void *item, void *state)
+{
+    const int *value;
+
+    (void)environment;
+    (void)state;
+    value = item;
+
+    return *value % 2 == 0;
+}
+
+static void count_removed(const struct dc_env *environment, struct dc_error *error, const void *item, void *state)
+{
+    size_t *count;
+
+    (void)environment;
+    (void)error;
+    (void)item;
+    count = state;
+    (*count)++;
+}
+
+Ensure(compact_list, remove_if_reuses_slots)
+{
+    static int values[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    struct dc_compact_list *list;
+    size_t count;
+
+    list = dc_compact_list_create(env, err, dc_string_comparator);
+
+    for(size_t i = 0; i < 8; i++)
+    {
+        dc_compact_list_add_last(env, err, list, &values[i]);
+    }
+
+    count = 0;
+    assert_that(dc_compact_list_remove_if(env, err, list, is_even, NULL, count_removed, &count), is_equal_to(4));
+    assert_that(count, is_equal_to(4));
+    assert_that(dc_compact_list_get_first(env, list).data, is_equal_to(&values[1]));
+    assert_that(used_slots(list), is_equal_to(8));
+
+    // the four slots remove_if freed are handed out again before the array grows
+    for(size_t i = 8; i < 12; i++)
+    {
+        dc_compact_list_add_last(env, err, list, &values[i]);
+    }
+
+    assert_that(used_slots(list), is_equal_to(8));
+    assert_that(dc_compact_list_get_last(env, list).data, is_equal_to(&values[11]));
+
+    assert_that(dc_compact_list_retain_if(env, err, list, is_even, NULL, NULL, NULL), is_equal_to(6));
+    assert_that(dc_compact_list_size(env, list), is_equal_to(2));
+    assert_that(dc_compact_list_get_first(env, list).data, is_equal_to(&values[8]));
+    assert_false(dc_error_has_error(err));
+    dc_compact_list_destroy(env, err, list);
+}
+
+Ensure(compact_list, splice_into_free_slots)
+{
+    static int values[20];
+    struct dc_compact_list *list;
+    struct dc_compact_list *other;
+    void *array[18];
+    size_t expected[18] = {0, 1, 16, 17, 18, 19, 2, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    list = dc_compact_list_create(env, err, dc_string_comparator);
+    other = dc_compact_list_create(env, err, dc_string_comparator);
+
+    // fill the first 16 slot array, then free two of its slots
+    for(size_t i = 0; i < 16; i++)
+    {
+        dc_compact_list_add_last(env, err, list, &values[i]);
+    }
+
+    for(size_t i = 16; i < 20; i++)
+    {
+        dc_compact_list_add_last(env, err, other, &values[i]);
+    }
+
+    dc_compact_list_remove_at(env, err, list, 7);
+    dc_compact_list_remove_at(env, err, list, 3);
+    assert_that(used_slots(list), is_equal_to(16));
+
+    // four items fill the two free slots and grow the array by the other two
+    dc_compact_list_splice(env, err, list, 2, other, 0, 4);
+    assert_false(dc_error_has_error(err));
+    assert_true(dc_compact_list_is_empty(env, other));
+    assert_that(dc_compact_list_size(env, list), is_equal_to(18));
+    assert_that(used_slots(list), is_equal_to(18));
+
+    dc_compact_list_to_array(env, list, array, 18);
+
+    for(size_t i = 0; i < 18; i++)
+    {
+        assert_that(array[i], is_equal_to(&values[expected[i]]));
+    }
+
+    assert_that(dc_compact_list_get_last(env, list).data, is_equal_to(&values[15]));
+    dc_compact_list_destroy(env, err, other);
+    dc_compact_list_destroy(env, err, list);
+}
+
+Ensure(compact_list, split_at_hands_over)
+{
+    static int values[6];
+    struct dc_compact_list *list;
+    struct dc_compact_list *tail_list;
+
+    list = dc_compact_list_create(env, err, dc_string_comparator);
+
+    for(size_t i = 0; i < 5; i++)
+    {
+        dc_compact_list_add_last(env, err, list, &values[i]);
+    }
+
+    dc_compact_list_remove_at(env, err, list, 2);
+
+    // a copy would only use four slots, the whole array moving keeps the free one
+    tail_list = dc_compact_list_split_at(env, err, list, 0);
+    assert_false(dc_error_has_error(err));
+    assert_true(dc_compact_list_is_empty(env, list));
+    assert_that(used_slots(list), is_equal_to(0));
+    assert_that(dc_compact_list_size(env, tail_list), is_equal_to(4));
+    assert_that(used_slots(tail_list), is_equal_to(5));
+    assert_that(dc_compact_list_get_at(env, tail_list, 2).data, is_equal_to(&values[3]));
+
+    dc_compact_list_add_last(env, err, tail_list, &values[5]);
+    assert_that(used_slots(tail_list), is_equal_to(5));
+
+    // concat into the now empty list hands the array back the same way
+    dc_compact_list_concat(env, err, list, tail_list);
+    assert_false(dc_error_has_error(err));
+    assert_true(dc_compact_list_is_empty(env, tail_list));
+    assert_that(used_slots(list), is_equal_to(5));
+    assert_that(dc_compact_list_get_last(env, list).data, is_equal_to(&values[5]));
+
+    dc_compact_list_destroy(env, err, tail_list);
+    dc_compact_list_destroy(env, err, list);
+}
+
+Ensure(compact_list, snapshot)
+{
+    static int values[1000];
+    struct dc_compact_list *list;
+    struct dc_compact_list *copy;
+    size_t size;
+    void *buffer;
+
+    list = dc_compact_list_create(env, err, dc_string_comparator);
+
+    for(size_t i = 0; i < 1000; i++)
+    {
+        dc_compact_list_add_last(env, err, list, &values[i]);
+    }
+
+    dc_compact_list_remove_at(env, err, list, 500);
+    size = dc_compact_list_snapshot_size(env, list);
+    buffer = malloc(size);
+    dc_compact_list_snapshot(env, list, buffer);
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_compact_list_size(env, copy), is_equal_to(999));
+    assert_that(dc_compact_list_get_at(env, copy, 500).data, is_equal_to(&values[501]));
+    assert_that(dc_compact_list_get_last(env, copy).data, is_equal_to(&values[999]));
+
+    dc_compact_list_restore(env, err, dc_string_comparator, buffer, size - 1);
+    assert_true(dc_error_has_error(err));
+
+    free(buffer);
+    dc_compact_list_destroy(env, err, copy);
+    dc_compact_list_destroy(env, err, list);
+}
+
+// next and then prev follow the data pointer
+static uint32_t *node_links(void *buffer, uint32_t slot)
+{
+    return (uint32_t *)((char *)buffer + SNAPSHOT_HEADER_SIZE + (slot * SNAPSHOT_NODE_SIZE) + sizeof(void *));
+}
+
+Ensure(compact_list, corrupted_snapshot)
+{
+    struct dc_compact_list *list;
+    struct dc_compact_list *copy;
+    size_t size;
+    uint32_t *header;
+    void *buffer;
+
+    list = dc_compact_list_create(env, err, dc_string_comparator);
+    dc_compact_list_add_last(env, err, list, "A");
+    size = dc_compact_list_snapshot_size(env, list);
+    buffer = malloc(size);
+
+    // the header is a 64-bit element count followed by used, head, tail and free_head
+    dc_compact_list_snapshot(env, list, buffer);
+    header = (uint32_t *)((char *)buffer + sizeof(uint64_t));
+    header[1] = 1000000;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    dc_compact_list_snapshot(env, list, buffer);
+    header[3] = 1;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    dc_compact_list_snapshot(env, list, buffer);
+    header[1] = UINT32_MAX;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    // the node's next link follows its data pointer
+    dc_compact_list_snapshot(env, list, buffer);
+    *(uint32_t *)((char *)buffer + size - (2 * sizeof(uint32_t))) = 7;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    free(buffer);
+    dc_compact_list_destroy(env, err, list);
+}
+
+Ensure(compact_list, corrupted_chain)
+{
+    struct dc_compact_list *list;
+    struct dc_compact_list *copy;
+    size_t size;
+    uint32_t *header;
+    void *buffer;
+
+    // slots 0 to 3 hold A to D and slot 4 is free
+    list = dc_compact_list_create(env, err, dc_string_comparator);
+    dc_compact_list_add_last(env, err, list, "A");
+    dc_compact_list_add_last(env, err, list, "B");
+    dc_compact_list_add_last(env, err, list, "C");
+    dc_compact_list_add_last(env, err, list, "D");
+    dc_compact_list_add_last(env, err, list, "E");
+    dc_compact_list_remove_last(env, err, list);
+    size = dc_compact_list_snapshot_size(env, list);
+    buffer = malloc(size);
+    header = (uint32_t *)((char *)buffer + sizeof(uint64_t));
+
+    dc_compact_list_snapshot(env, list, buffer);
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_compact_list_get_at(env, copy, 3).data, is_equal_to_string("D"));
+    dc_compact_list_destroy(env, err, copy);
+
+    // the chain ends after one item but the count says four
+    dc_compact_list_snapshot(env, list, buffer);
+    header[2] = 0;
+    node_links(buffer, 0)[0] = UINT32_MAX;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    // D links back to B, so the chain never reaches the tail
+    dc_compact_list_snapshot(env, list, buffer);
+    node_links(buffer, 3)[0] = 1;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    // the free list starts at a live slot
+    dc_compact_list_snapshot(env, list, buffer);
+    header[3] = 2;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    // the free list starts at the head, whose back link is NIL like a free slot's
+    dc_compact_list_snapshot(env, list, buffer);
+    header[3] = 0;
+    copy = dc_compact_list_restore(env, err, dc_string_comparator, buffer, size);
+    assert_true(dc_error_has_error(err));
+    assert_that(copy, is_null);
+    dc_error_reset(err);
+
+    free(buffer);
+    dc_compact_list_destroy(env, err, list);
+}
+
+TestSuite *compact_list_tests(void)
+{
+    TestSuite *suite;
+
+    suite = create_test_suite();
+    add_test_with_context(suite, compact_list, add_remove);
+    add_test_with_context(suite, compact_list, remove_if_reuses_slots);
+    add_test_with_context(suite, compact_list, splice_into_free_slots);
+    add_test_with_context(suite, compact_list, split_at_hands_over);
+    add_test_with_context(suite, compact_list, snapshot);
+    add_test_with_context(suite, compact_list, corrupted_snapshot);
+    add_test_with_context(suite, compact_list, corrupted_chain);
+
+    return suite;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
@@ -2,6 +2,7 @@
 #include "dc_collections/linked_list.h"
 #include <dc_env/env.h>
 #include <dc_error/error.h>
+#include <string.h>
 
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
@@ -45,12 +46,127 @@ Ensure(linked_list, test)
     assert_that(item.data, is_equal_to("Hello"));
 }
 
+static bool starts_with(const struct dc_env *environment, const void *item, void *state)
+{
+    const char *str;
+    const char *prefix;
+
+    (void)environment;
+    str = item;
+    prefix = state;
+
+    return strncmp(str, prefix, strlen(prefix)) == 0;
+}
+
+static void count_removed(const struct dc_env *environment, struct dc_error *error, const void *item, void *state)
+{
+    size_t *count;
+
+    (void)environment;
+    (void)error;
+    (void)item;
+    count = state;
+    (*count)++;
+}
+
+Ensure(linked_list, remove_if)
+{
+    struct dc_linked_list *list;
+    char a_prefix[] = "a";
+    char b2_prefix[] = "b2";
+    size_t removed;
+    size_t count;
+
+    list = dc_linked_list_create(env, err, dc_string_comparator);
+    dc_linked_list_add_last(env, err, list, "a1");
+    dc_linked_list_add_last(env, err, list, "b1");
+    dc_linked_list_add_last(env, err, list, "a2");
+    dc_linked_list_add_last(env, err, list, "b2");
+    dc_linked_list_add_last(env, err, list, "a3");
+    assert_false(dc_error_has_error(err));
+
+    count = 0;
+    removed = dc_linked_list_remove_if(env, err, list, starts_with, a_prefix, count_removed, &count);
+    assert_false(dc_error_has_error(err));
+    assert_that(removed, is_equal_to(3));
+    assert_that(count, is_equal_to(3));
+    assert_that(dc_linked_list_size(env, list), is_equal_to(2));
+    assert_that(dc_linked_list_get_first(env, list).data, is_equal_to_string("b1"));
+    assert_that(dc_linked_list_get_last(env, list).data, is_equal_to_string("b2"));
+
+    removed = dc_linked_list_retain_if(env, err, list, starts_with, b2_prefix, NULL, NULL);
+    assert_false(dc_error_has_error(err));
+    assert_that(removed, is_equal_to(1));
+    assert_that(dc_linked_list_size(env, list), is_equal_to(1));
+    assert_that(dc_linked_list_get_first(env, list).data, is_equal_to_string("b2"));
+
+    removed = dc_linked_list_remove_all_occurrences(env, err, list, "b2");
+    assert_false(dc_error_has_error(err));
+    assert_that(removed, is_equal_to(1));
+    assert_true(dc_linked_list_is_empty(env, list));
+    dc_linked_list_destroy(env, err, list);
+}
+
+Ensure(linked_list, concat_splice_split)
+{
+    struct dc_linked_list *list;
+    struct dc_linked_list *other;
+    struct dc_linked_list *tail_list;
+
+    list = dc_linked_list_create(env, err, dc_string_comparator);
+    other = dc_linked_list_create(env, err, dc_string_comparator);
+    dc_linked_list_add_last(env, err, list, "A");
+    dc_linked_list_add_last(env, err, list, "B");
+    dc_linked_list_add_last(env, err, other, "C");
+    dc_linked_list_add_last(env, err, other, "D");
+    dc_linked_list_add_last(env, err, other, "E");
+
+    dc_linked_list_concat(env, err, list, other);
+    assert_false(dc_error_has_error(err));
+    assert_true(dc_linked_list_is_empty(env, other));
+    assert_that(dc_linked_list_size(env, list), is_equal_to(5));
+    assert_that(dc_linked_list_get_at(env, list, 2).data, is_equal_to_string("C"));
+    assert_that(dc_linked_list_get_last(env, list).data, is_equal_to_string("E"));
+
+    // A B C D E -> A D E, with B C moved to the empty list
+    dc_linked_list_splice(env, err, other, 0, list, 1, 3);
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_linked_list_size(env, list), is_equal_to(3));
+    assert_that(dc_linked_list_size(env, other), is_equal_to(2));
+    assert_that(dc_linked_list_get_at(env, list, 1).data, is_equal_to_string("D"));
+    assert_that(dc_linked_list_get_first(env, other).data, is_equal_to_string("B"));
+    assert_that(dc_linked_list_get_last(env, other).data, is_equal_to_string("C"));
+
+    // A D E -> A B C D E
+    dc_linked_list_splice(env, err, list, 1, other, 0, 2);
+    assert_false(dc_error_has_error(err));
+    assert_true(dc_linked_list_is_empty(env, other));
+    assert_that(dc_linked_list_get_at(env, list, 1).data, is_equal_to_string("B"));
+    assert_that(dc_linked_list_get_at(env, list, 3).data, is_equal_to_string("D"));
+
+    tail_list = dc_linked_list_split_at(env, err, list, 3);
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_linked_list_size(env, list), is_equal_to(3));
+    assert_that(dc_linked_list_size(env, tail_list), is_equal_to(2));
+    assert_that(dc_linked_list_get_last(env, list).data, is_equal_to_string("C"));
+    assert_that(dc_linked_list_get_first(env, tail_list).data, is_equal_to_string("D"));
+
+    dc_linked_list_splice(env, err, list, 4, tail_list, 0, 1);
+    assert_true(dc_error_has_error(err));
+
+    dc_linked_list_destroy(env, err, tail_list);
+    dc_linked_list_destroy(env, err, other);
+    dc_linked_list_destroy(env, err, list);
+}
+
 TestSuite *linked_list_tests(void)
 {
     TestSuite *suite;
 
     suite = create_test_suite();
     add_test_with_context(suite, linked_list, test);
+    add_test_with_context(suite, linked_list, remove_if);
+    add_test_with_context(suite, linked_list, concat_splice_split);
 
     return suite;
 }
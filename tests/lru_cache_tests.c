@@ -0,0 +1,168 @@
+#include "tests.h"
+#include "dc_collections/lru_cache.h"
+#include <dc_env/env.h>
+#include <dc_error/error.h>
+#include <pthread.h>
+#include <stdio.h>
+
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+
+#define NUMBER_OF_THREADS 4
+#define NUMBER_OF_KEYS 512
+
+static struct dc_env *env;
+static struct dc_error *err;
+static char keys[NUMBER_OF_KEYS][8];
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+Describe(lru_cache);
+#pragma GCC diagnostic pop
+
+BeforeEach(lru_cache)
+{
+    err = dc_error_create(false);
+    env = dc_env_create(err, false, NULL);
+
+    for(int i = 0; i < NUMBER_OF_KEYS; i++)
+    {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+    }
+}
+
+AfterEach(lru_cache)
+{
+    free(env);
+    dc_error_reset(err);
+    free(err);
+}
+
+struct evicted
+{
+    size_t count;
+    const void *last_key;
+};
+
+static void record_eviction(const struct dc_env *environment, struct dc_error *error, const void *key, void *value, void *state)
+{
+    struct evicted *evicted;
+
+    (void)environment;
+    (void)error;
+    (void)value;
+    evicted = state;
+    evicted->count++;
+    evicted->last_key = key;
+}
+
+Ensure(lru_cache, evicts_least_recently_used)
+{
+    struct dc_lru_cache *cache;
+    struct dc_lru_cache_stats stats;
+    struct evicted evicted;
+
+    evicted.count = 0;
+    evicted.last_key = NULL;
+    cache = dc_lru_cache_create(env, err, 3, 0, dc_string_hasher, dc_string_comparator, record_eviction, &evicted);
+    assert_false(dc_error_has_error(err));
+
+    dc_lru_cache_put(env, err, cache, "a", "1");
+    dc_lru_cache_put(env, err, cache, "b", "2");
+    dc_lru_cache_put(env, err, cache, "c", "3");
+    assert_that(dc_lru_cache_size(env, cache), is_equal_to(3));
+
+    // touching a makes b the least recently used
+    assert_that(dc_lru_cache_get(env, cache, "a"), is_equal_to_string("1"));
+    dc_lru_cache_put(env, err, cache, "d", "4");
+    assert_that(evicted.count, is_equal_to(1));
+    assert_that(evicted.last_key, is_equal_to_string("b"));
+    assert_that(dc_lru_cache_get(env, cache, "b"), is_null);
+
+    assert_true(dc_lru_cache_move_to_front(env, cache, "c"));
+    assert_that(dc_lru_cache_put(env, err, cache, "a", "one"), is_equal_to_string("1"));
+    dc_lru_cache_put(env, err, cache, "e", "5");
+    assert_that(evicted.last_key, is_equal_to_string("d"));
+    assert_that(dc_lru_cache_peek(env, cache, "a"), is_equal_to_string("one"));
+
+    assert_that(dc_lru_cache_remove(env, err, cache, "c"), is_equal_to_string("3"));
+    assert_that(dc_lru_cache_size(env, cache), is_equal_to(2));
+    dc_lru_cache_put(env, err, cache, "f", "6");
+    assert_that(evicted.count, is_equal_to(2));
+
+    stats = dc_lru_cache_get_stats(env, cache);
+    assert_that(stats.hits, is_equal_to(1));
+    assert_that(stats.misses, is_equal_to(1));
+    assert_that(stats.evictions, is_equal_to(2));
+
+    dc_lru_cache_clear(env, err, cache);
+    assert_that(dc_lru_cache_size(env, cache), is_equal_to(0));
+    assert_false(dc_error_has_error(err));
+    dc_lru_cache_destroy(env, err, cache);
+}
+
+static void *hammer(void *arg)
+{
+    struct dc_lru_cache *cache;
+    struct dc_error *error;
+
+    cache = arg;
+    error = dc_error_create(false);
+
+    for(int round = 0; round < 50; round++)
+    {
+        for(int i = 0; i < NUMBER_OF_KEYS; i++)
+        {
+            if(dc_lru_cache_get(env, cache, keys[i]) == NULL)
+            {
+                dc_lru_cache_put(env, error, cache, keys[i], keys[i]);
+            }
+        }
+    }
+
+    free(error);
+
+    return NULL;
+}
+
+Ensure(lru_cache, sharded)
+{
+    struct dc_lru_cache *cache;
+    struct dc_lru_cache_stats stats;
+    pthread_t threads[NUMBER_OF_THREADS];
+
+    cache = dc_lru_cache_create(env, err, 256, 8, dc_string_hasher, dc_string_comparator, NULL, NULL);
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_lru_cache_capacity(env, cache), is_equal_to(256));
+
+    for(int i = 0; i < NUMBER_OF_THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, hammer, cache);
+    }
+
+    for(int i = 0; i < NUMBER_OF_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    stats = dc_lru_cache_get_stats(env, cache);
+    assert_that(stats.hits + stats.misses, is_equal_to(NUMBER_OF_THREADS * 50 * NUMBER_OF_KEYS));
+    assert_that(dc_lru_cache_size(env, cache), is_equal_to(256));
+    dc_lru_cache_destroy(env, err, cache);
+
+    dc_lru_cache_create(env, err, 4, 8, dc_string_hasher, dc_string_comparator, NULL, NULL);
+    assert_true(dc_error_has_error(err));
+}
+
+TestSuite *lru_cache_tests(void)
+{
+    TestSuite *suite;
+
+    suite = create_test_suite();
+    add_test_with_context(suite, lru_cache, evicts_least_recently_used);
+    add_test_with_context(suite, lru_cache, sharded);
+
+    return suite;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
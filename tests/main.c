@@ -11,6 +11,11 @@ int main(int argc, char **argv)
     reporter = create_text_reporter();
 
     add_suite(suite, linked_list_tests());
+    add_suite(suite, lru_cache_tests());
+    add_suite(suite, small_list_tests());
+    add_suite(suite, compact_list_tests());
+    add_suite(suite, radix_tree_tests());
+    add_suite(suite, skip_list_tests());
 
     if(argc > 1)
     {
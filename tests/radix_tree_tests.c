@@ -0,0 +1,207 @@
+#include "tests.h"
+#include "dc_collections/radix_tree.h"
+#include <dc_env/env.h>
+#include <dc_error/error.h>
+#include <stdio.h>
+#include <string.h>
+
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+
+static struct dc_env *env;
+static struct dc_error *err;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+Describe(radix_tree);
+#pragma GCC diagnostic pop
+
+BeforeEach(radix_tree)
+{
+    err = dc_error_create(false);
+    env = dc_env_create(err, false, NULL);
+}
+
+AfterEach(radix_tree)
+{
+    free(env);
+    dc_error_reset(err);
+    free(err);
+}
+
+struct collected
+{
+    size_t count;
+    const char *items[8];
+    bool sorted;
+    const char *last;
+};
+
+static void collect(const struct dc_env *environment, struct dc_error *error, const void *item, void *state)
+{
+    struct collected *collected;
+
+    (void)environment;
+    (void)error;
+    collected = state;
+
+    if(collected->last && strcmp(collected->last, item) >= 0)
+    {
+        collected->sorted = false;
+    }
+
+    if(collected->count < 8)
+    {
+        collected->items[collected->count] = item;
+    }
+
+    collected->last = item;
+    collected->count++;
+}
+
+Ensure(radix_tree, prefixes)
+{
+    struct dc_radix_tree *tree;
+    struct collected collected;
+
+    tree = dc_radix_tree_create(env, err);
+    assert_true(dc_radix_tree_insert(env, err, tree, "romane"));
+    assert_true(dc_radix_tree_insert(env, err, tree, "romanus"));
+    assert_true(dc_radix_tree_insert(env, err, tree, "romulus"));
+    assert_true(dc_radix_tree_insert(env, err, tree, "rubens"));
+    assert_true(dc_radix_tree_insert(env, err, tree, "ruber"));
+    assert_true(dc_radix_tree_insert(env, err, tree, "rom"));
+    assert_true(dc_radix_tree_insert(env, err, tree, ""));
+    assert_false(dc_radix_tree_insert(env, err, tree, "ruber"));
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_radix_tree_size(env, tree), is_equal_to(7));
+
+    assert_true(dc_radix_tree_contains(env, tree, "rom"));
+    assert_true(dc_radix_tree_contains(env, tree, ""));
+    assert_false(dc_radix_tree_contains(env, tree, "roman"));
+    assert_false(dc_radix_tree_contains(env, tree, "romanes"));
+
+    memset(&collected, 0, sizeof(collected));
+    dc_radix_tree_visit_prefix(env, err, tree, "roma", collect, &collected);
+    assert_that(collected.count, is_equal_to(2));
+    assert_that(collected.items[0], is_equal_to_string("romane"));
+    assert_that(collected.items[1], is_equal_to_string("romanus"));
+
+    memset(&collected, 0, sizeof(collected));
+    dc_radix_tree_visit_prefix(env, err, tree, "rom", collect, &collected);
+    assert_that(collected.count, is_equal_to(4));
+    assert_that(collected.items[0], is_equal_to_string("rom"));
+
+    memset(&collected, 0, sizeof(collected));
+    dc_radix_tree_visit_prefix(env, err, tree, "rx", collect, &collected);
+    assert_that(collected.count, is_equal_to(0));
+
+    assert_that(dc_radix_tree_remove(env, err, tree, "rom"), is_equal_to_string("rom"));
+    assert_that(dc_radix_tree_remove(env, err, tree, "rom"), is_null);
+    assert_that(dc_radix_tree_remove(env, err, tree, "romane"), is_equal_to_string("romane"));
+    assert_true(dc_radix_tree_contains(env, tree, "romanus"));
+
+    collected.sorted = true;
+    collected.count = 0;
+    collected.last = NULL;
+    dc_radix_tree_visit(env, err, tree, collect, &collected);
+    assert_that(collected.count, is_equal_to(5));
+    assert_true(collected.sorted);
+    assert_false(dc_error_has_error(err));
+    dc_radix_tree_destroy(env, err, tree);
+}
+
+Ensure(radix_tree, node_sizes)
+{
+    static char keys[255][3];
+    static char numbers[2000][8];
+    struct dc_radix_tree *tree;
+    struct collected collected;
+
+    tree = dc_radix_tree_create(env, err);
+
+    // one byte under a shared first byte takes a node through all four sizes
+    for(size_t i = 0; i < 255; i++)
+    {
+        keys[i][0] = 'k';
+        keys[i][1] = (char)(i + 1);
+        assert_true(dc_radix_tree_insert(env, err, tree, keys[i]));
+    }
+
+    for(size_t i = 0; i < 2000; i++)
+    {
+        snprintf(numbers[i], sizeof(numbers[i]), "%zu", i * 7);
+        assert_true(dc_radix_tree_insert(env, err, tree, numbers[i]));
+    }
+
+    assert_that(dc_radix_tree_size(env, tree), is_equal_to(2255));
+
+    collected.sorted = true;
+    collected.count = 0;
+    collected.last = NULL;
+    dc_radix_tree_visit(env, err, tree, collect, &collected);
+    assert_that(collected.count, is_equal_to(2255));
+    assert_true(collected.sorted);
+
+    for(size_t i = 0; i < 255; i += 2)
+    {
+        assert_that(dc_radix_tree_remove(env, err, tree, keys[i]), is_equal_to(keys[i]));
+    }
+
+    for(size_t i = 0; i < 2000; i++)
+    {
+        assert_that(dc_radix_tree_contains(env, tree, numbers[i]), is_equal_to(true));
+        assert_that(dc_radix_tree_remove(env, err, tree, numbers[i]), is_equal_to(numbers[i]));
+    }
+
+    for(size_t i = 0; i < 255; i++)
+    {
+        assert_that(dc_radix_tree_contains(env, tree, keys[i]), is_equal_to(i % 2 == 1));
+    }
+
+    assert_that(dc_radix_tree_size(env, tree), is_equal_to(127));
+    assert_false(dc_error_has_error(err));
+    dc_radix_tree_destroy(env, err, tree);
+}
+
+Ensure(radix_tree, removed_key_outlives_prefix)
+{
+    struct dc_radix_tree *tree;
+    char key[] = "abc";
+
+    tree = dc_radix_tree_create(env, err);
+
+    // the abc leaf grows children while its prefix still points into key
+    assert_true(dc_radix_tree_insert(env, err, tree, key));
+    assert_true(dc_radix_tree_insert(env, err, tree, "abcx"));
+    assert_true(dc_radix_tree_insert(env, err, tree, "abcy"));
+    assert_that(dc_radix_tree_remove(env, err, tree, key), is_equal_to(key));
+
+    // the string is the caller's again once it is removed
+    memset(key, 'z', sizeof(key) - 1);
+    assert_true(dc_radix_tree_contains(env, tree, "abcx"));
+    assert_true(dc_radix_tree_contains(env, tree, "abcy"));
+    assert_false(dc_radix_tree_contains(env, tree, "abc"));
+
+    // folding a node into a child borrows the longer prefix from the child's key
+    assert_that(dc_radix_tree_remove(env, err, tree, "abcx"), is_equal_to_string("abcx"));
+    assert_true(dc_radix_tree_contains(env, tree, "abcy"));
+    assert_false(dc_radix_tree_contains(env, tree, "abc"));
+    assert_that(dc_radix_tree_size(env, tree), is_equal_to(1));
+    assert_false(dc_error_has_error(err));
+    dc_radix_tree_destroy(env, err, tree);
+}
+
+TestSuite *radix_tree_tests(void)
+{
+    TestSuite *suite;
+
+    suite = create_test_suite();
+    add_test_with_context(suite, radix_tree, prefixes);
+    add_test_with_context(suite, radix_tree, node_sizes);
+    add_test_with_context(suite, radix_tree, removed_key_outlives_prefix);
+
+    return suite;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
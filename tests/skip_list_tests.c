@@ -0,0 +1,278 @@
+#include "tests.h"
+#include "dc_collections/skip_list.h"
+#include <dc_env/env.h>
+#include <dc_error/error.h>
+#include <pthread.h>
+
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+
+#define NUMBER_OF_WRITERS 4
+#define NUMBER_OF_READERS 4
+#define ITEMS_PER_WRITER 5000
+
+static struct dc_env *env;
+static struct dc_error *err;
+static int values[NUMBER_OF_WRITERS * ITEMS_PER_WRITER];
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+Describe(skip_list);
+#pragma GCC diagnostic pop
+
+BeforeEach(skip_list)
+{
+    err = dc_error_create(false);
+    env = dc_env_create(err, false, NULL);
+
+    for(int i = 0; i < NUMBER_OF_WRITERS * ITEMS_PER_WRITER; i++)
+    {
+        values[i] = i;
+    }
+}
+
+AfterEach(skip_list)
+{
+    free(env);
+    dc_error_reset(err);
+    free(err);
+}
+
+static int int_comparator(const struct dc_env *environment, const void *item_a, const void *item_b)
+{
+    int value_a;
+    int value_b;
+
+    (void)environment;
+    value_a = *(const int *)item_a;
+    value_b = *(const int *)item_b;
+
+    return (value_a > value_b) - (value_a < value_b);
+}
+
+struct ordered
+{
+    size_t count;
+    int last;
+    bool sorted;
+};
+
+static void check_order(const struct dc_env *environment, struct dc_error *error, const void *item, void *state)
+{
+    struct ordered *ordered;
+    int value;
+
+    (void)environment;
+    (void)error;
+    ordered = state;
+    value = *(const int *)item;
+
+    if(ordered->count > 0 && value <= ordered->last)
+    {
+        ordered->sorted = false;
+    }
+
+    ordered->last = value;
+    ordered->count++;
+}
+
+Ensure(skip_list, ordered)
+{
+    struct dc_skip_list *list;
+    struct ordered ordered;
+
+    list = dc_skip_list_create(env, err, int_comparator, false);
+
+    // insert in a scrambled order, 7919 is prime so this hits every value once
+    for(int i = 0; i < 1000; i++)
+    {
+        assert_true(dc_skip_list_add(env, err, list, &values[(i * 7919) % 1000]));
+    }
+
+    assert_false(dc_skip_list_add(env, err, list, &values[10]));
+    assert_that(dc_skip_list_size(env, list), is_equal_to(1000));
+
+    for(int i = 0; i < 1000; i += 3)
+    {
+        assert_that(dc_skip_list_remove(env, err, list, &values[i]), is_equal_to(&values[i]));
+    }
+
+    assert_that(dc_skip_list_remove(env, err, list, &values[0]), is_null);
+    assert_that(dc_skip_list_size(env, list), is_equal_to(666));
+
+    // 1, 2, 4, 5, 7, 8, ... so index i holds (i / 2) * 3 + (i % 2) + 1
+    for(size_t i = 0; i < 666; i++)
+    {
+        struct dc_skip_list_item item;
+
+        item = dc_skip_list_get_at(env, list, i);
+        assert_that(*(int *)item.data, is_equal_to((i / 2) * 3 + (i % 2) + 1));
+        assert_that(dc_skip_list_index_of(env, list, item.data), is_equal_to(i));
+    }
+
+    assert_that(dc_skip_list_get_at(env, list, 666).index, is_equal_to(-1));
+    assert_that(dc_skip_list_index_of(env, list, &values[3]), is_equal_to(-1));
+
+    ordered.count = 0;
+    ordered.sorted = true;
+    dc_skip_list_visit(env, err, list, check_order, &ordered);
+    assert_that(ordered.count, is_equal_to(666));
+    assert_true(ordered.sorted);
+
+    ordered.count = 0;
+    dc_skip_list_visit_range(env, err, list, &values[100], &values[110], check_order, &ordered);
+    assert_that(ordered.count, is_equal_to(7));
+    assert_false(dc_error_has_error(err));
+    dc_skip_list_destroy(env, err, list);
+}
+
+struct worker
+{
+    struct dc_skip_list *list;
+    int id;
+    bool ok;
+};
+
+static void *writer(void *arg)
+{
+    struct worker *worker;
+    struct dc_error *error;
+
+    worker = arg;
+    error = dc_error_create(false);
+
+    // writers interleave their values so they contend for the same neighbourhoods
+    for(int i = 0; i < ITEMS_PER_WRITER; i++)
+    {
+        int index;
+
+        index = (i * NUMBER_OF_WRITERS) + worker->id;
+
+        if(!dc_skip_list_add(env, error, worker->list, &values[index]))
+        {
+            worker->ok = false;
+        }
+    }
+
+    for(int i = 0; i < ITEMS_PER_WRITER; i += 2)
+    {
+        int index;
+
+        index = (i * NUMBER_OF_WRITERS) + worker->id;
+
+        if(dc_skip_list_remove(env, error, worker->list, &values[index]) != &values[index])
+        {
+            worker->ok = false;
+        }
+    }
+
+    if(dc_error_has_error(error))
+    {
+        worker->ok = false;
+    }
+
+    free(error);
+
+    return NULL;
+}
+
+static void *reader(void *arg)
+{
+    struct worker *worker;
+    struct dc_error *error;
+
+    worker = arg;
+    error = dc_error_create(false);
+
+    for(int pass = 0; pass < 20; pass++)
+    {
+        struct ordered ordered;
+
+        ordered.count = 0;
+        ordered.sorted = true;
+        dc_skip_list_visit(env, error, worker->list, check_order, &ordered);
+
+        if(!ordered.sorted)
+        {
+            worker->ok = false;
+        }
+
+        for(int i = 0; i < NUMBER_OF_WRITERS * ITEMS_PER_WRITER; i += 97)
+        {
+            void *found;
+
+            found = dc_skip_list_get(env, worker->list, &values[i]);
+
+            if(found != NULL && found != &values[i])
+            {
+                worker->ok = false;
+            }
+        }
+    }
+
+    free(error);
+
+    return NULL;
+}
+
+Ensure(skip_list, concurrent)
+{
+    struct dc_skip_list *list;
+    pthread_t threads[NUMBER_OF_WRITERS + NUMBER_OF_READERS];
+    struct worker workers[NUMBER_OF_WRITERS + NUMBER_OF_READERS];
+    struct ordered ordered;
+
+    list = dc_skip_list_create(env, err, int_comparator, true);
+
+    for(int i = 0; i < NUMBER_OF_WRITERS + NUMBER_OF_READERS; i++)
+    {
+        workers[i].list = list;
+        workers[i].id = i;
+        workers[i].ok = true;
+        pthread_create(&threads[i], NULL, i < NUMBER_OF_WRITERS ? writer : reader, &workers[i]);
+    }
+
+    for(int i = 0; i < NUMBER_OF_WRITERS + NUMBER_OF_READERS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        assert_true(workers[i].ok);
+    }
+
+    // every writer removed the even positions of its own values
+    assert_that(dc_skip_list_size(env, list), is_equal_to(NUMBER_OF_WRITERS * ITEMS_PER_WRITER / 2));
+
+    for(int i = 0; i < NUMBER_OF_WRITERS * ITEMS_PER_WRITER; i++)
+    {
+        bool expected;
+
+        expected = ((i / NUMBER_OF_WRITERS) % 2) == 1;
+
+        if(dc_skip_list_contains(env, list, &values[i]) != expected)
+        {
+            assert_that(i, is_equal_to(-1));
+        }
+    }
+
+    dc_skip_list_reclaim(env, list);
+    ordered.count = 0;
+    ordered.sorted = true;
+    dc_skip_list_visit(env, err, list, check_order, &ordered);
+    assert_that(ordered.count, is_equal_to(NUMBER_OF_WRITERS * ITEMS_PER_WRITER / 2));
+    assert_true(ordered.sorted);
+    assert_that(dc_skip_list_index_of(env, list, &values[NUMBER_OF_WRITERS]), is_equal_to(0));
+    assert_false(dc_error_has_error(err));
+    dc_skip_list_destroy(env, err, list);
+}
+
+TestSuite *skip_list_tests(void)
+{
+    TestSuite *suite;
+
+    suite = create_test_suite();
+    add_test_with_context(suite, skip_list, ordered);
+    add_test_with_context(suite, skip_list, concurrent);
+
+    return suite;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
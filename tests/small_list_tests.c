@@ -0,0 +1,118 @@
+#include "tests.h"
+#include "dc_collections/small_list.h"
+#include <dc_env/env.h>
+#include <dc_error/error.h>
+
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+
+static struct dc_env *env;
+static struct dc_error *err;
+
+static const char *words[] = { "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+Describe(small_list);
+#pragma GCC diagnostic pop
+
+BeforeEach(small_list)
+{
+    err = dc_error_create(false);
+    env = dc_env_create(err, false, NULL);
+}
+
+AfterEach(small_list)
+{
+    free(env);
+    dc_error_reset(err);
+    free(err);
+}
+
+Ensure(small_list, inline_only)
+{
+    struct dc_small_list list;
+
+    dc_small_list_init(env, err, &list, dc_string_comparator);
+    assert_false(dc_error_has_error(err));
+    assert_true(dc_small_list_is_empty(env, &list));
+
+    dc_small_list_add_last(env, err, &list, words[1]);
+    dc_small_list_add_last(env, err, &list, words[3]);
+    dc_small_list_add_first(env, err, &list, words[0]);
+    dc_small_list_add_at(env, err, &list, 2, words[2]);
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_small_list_size(env, &list), is_equal_to(4));
+    assert_that(list.overflow_head, is_null);
+
+    for(size_t i = 0; i < 4; i++)
+    {
+        assert_that(dc_small_list_get_at(env, &list, i).data, is_equal_to_string(words[i]));
+    }
+
+    assert_that(dc_small_list_remove_first(env, err, &list).data, is_equal_to_string("zero"));
+    assert_that(dc_small_list_get_first(env, &list).data, is_equal_to_string("one"));
+    assert_that(dc_small_list_index_of(env, &list, "three"), is_equal_to(2));
+    dc_small_list_clear(env, err, &list);
+    assert_false(dc_error_has_error(err));
+}
+
+Ensure(small_list, spill)
+{
+    struct dc_small_list *list;
+    struct dc_small_list_item item;
+
+    list = dc_small_list_create(env, err, dc_string_comparator);
+
+    for(size_t i = 0; i < 10; i += 2)
+    {
+        dc_small_list_add_last(env, err, list, words[i]);
+    }
+
+    // fill in the odd words, the early ones push inline items into the overflow chain
+    for(size_t i = 1; i < 10; i += 2)
+    {
+        dc_small_list_add_at(env, err, list, i, words[i]);
+    }
+
+    assert_false(dc_error_has_error(err));
+    assert_that(dc_small_list_size(env, list), is_equal_to(10));
+
+    for(size_t i = 0; i < 10; i++)
+    {
+        assert_that(dc_small_list_get_at(env, list, i).data, is_equal_to_string(words[i]));
+    }
+
+    assert_true(dc_small_list_contains(env, list, "eight"));
+    assert_that(dc_small_list_index_of(env, list, "seven"), is_equal_to(7));
+    assert_that(dc_small_list_set(env, err, list, 6, "SIX"), is_equal_to_string("six"));
+
+    item = dc_small_list_remove_at(env, err, list, 1);
+    assert_that(item.data, is_equal_to_string("one"));
+    assert_that(dc_small_list_get_at(env, list, 3).data, is_equal_to_string("four"));
+    assert_that(dc_small_list_get_at(env, list, 5).data, is_equal_to_string("SIX"));
+    assert_that(dc_small_list_remove_last(env, err, list).data, is_equal_to_string("nine"));
+
+    while(!dc_small_list_is_empty(env, list))
+    {
+        dc_small_list_remove_first(env, err, list);
+    }
+
+    assert_false(dc_error_has_error(err));
+    assert_that(list->overflow_head, is_null);
+    assert_that(dc_small_list_get_last(env, list).index, is_equal_to(-1));
+    dc_small_list_destroy(env, err, list);
+}
+
+TestSuite *small_list_tests(void)
+{
+    TestSuite *suite;
+
+    suite = create_test_suite();
+    add_test_with_context(suite, small_list, inline_only);
+    add_test_with_context(suite, small_list, spill);
+
+    return suite;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
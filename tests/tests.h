@@ -6,6 +6,11 @@
 
 
 TestSuite *linked_list_tests(void);
+TestSuite *lru_cache_tests(void);
+TestSuite *small_list_tests(void);
+TestSuite *compact_list_tests(void);
+TestSuite *radix_tree_tests(void);
+TestSuite *skip_list_tests(void);
 
 
 #endif // LIBDC_POSIX_TESTS_H